@@ -0,0 +1,157 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef OATPP_FLATBUFFERS_ALIGNED_BODY_READER_HPP
+#define OATPP_FLATBUFFERS_ALIGNED_BODY_READER_HPP
+
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+#include "BufferPool.hpp"
+#include "ContentEncoding.hpp"
+
+#include "oatpp/async/Coroutine.hpp"
+#include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/IODefinitions.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 把整个请求 body 直接读入 BufferPool 的池化缓冲（起始地址至少 16 字节对齐），
+ * 再通过 `ObjectMapper::readFromBuffer()` 零拷贝地包装为 `Object<T>`。
+ *
+ * - 与 `readBodyToDtoAsync` 相比省去中间 String，且借用的根指针总是满足
+ *   `force_align` / 宽标量的对齐要求；对象存活期间持有池化缓冲，释放后缓冲回到池中。
+ * - 需要已知 Content-Length；流给出的是传输层已解码（非 chunked）的 body 字节（同 FrameReader）。
+ * - 给出 Content-Encoding（gzip / zstd / lz4）时，压缩 body 先读入一个池化缓冲，再直接解压到
+ *   另一个池化缓冲作为对象的自有存储；压缩缓冲随即归还，中间不经过 String。
+ *
+ * @tparam T - FlatBuffers 生成的 Table 类型
+ */
+template<typename T>
+class AlignedBodyReader : public oatpp::async::Coroutine<AlignedBodyReader<T>> {
+public:
+  using Callback = std::function<oatpp::async::CoroutineStarter(const Object<T>&)>;
+  using Action = oatpp::async::Action;
+private:
+  std::shared_ptr<oatpp::data::stream::InputStream> m_stream;
+  std::shared_ptr<ObjectMapper> m_mapper;
+  Callback m_callback;
+  v_int64 m_contentLength;
+  v_buff_size m_maxBodySize;
+  oatpp::String m_contentEncoding;
+  std::shared_ptr<Arena> m_arena;
+  std::shared_ptr<std::vector<uint8_t>> m_buffer;
+  v_buff_size m_filled = 0;
+public:
+
+  /**
+   * Constructor.
+   * @param stream - 已解码的 body 输入流。
+   * @param mapper - 用于构造 `Object<T>` 的 ObjectMapper。
+   * @param callback - 读完后的回调。
+   * @param contentLength - body 长度（必须已知）。
+   * @param maxBodySize - body 上限（压缩时同时约束解压后的大小），超过即报错。
+   * @param contentEncoding - 请求的 Content-Encoding；nullptr 或 identity 表示未压缩。
+   * @param arena - 请求 Arena；缓冲无法借用（如根表未对齐）而需要拷贝时，拷贝放在其中。可为 nullptr。
+   */
+  AlignedBodyReader(const std::shared_ptr<oatpp::data::stream::InputStream>& stream,
+                    const std::shared_ptr<ObjectMapper>& mapper,
+                    const Callback& callback,
+                    v_int64 contentLength,
+                    v_buff_size maxBodySize = 16 * 1024 * 1024,
+                    const oatpp::String& contentEncoding = nullptr,
+                    const std::shared_ptr<Arena>& arena = nullptr)
+    : m_stream(stream)
+    , m_mapper(mapper)
+    , m_callback(callback)
+    , m_contentLength(contentLength)
+    , m_maxBodySize(maxBodySize)
+    , m_contentEncoding(contentEncoding)
+    , m_arena(arena)
+  {}
+
+  Action act() override {
+    ContentEncoding::Codec codec;
+    if (!ContentEncoding::parse(m_contentEncoding, codec) || !ContentEncoding::isAvailable(codec)) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::AlignedBodyReader::act()]: Unsupported Content-Encoding");
+    }
+    if (m_contentLength < 4 || m_contentLength > m_maxBodySize) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::AlignedBodyReader::act()]: Invalid or missing Content-Length");
+    }
+    m_buffer = BufferPool::instance().acquire(static_cast<v_buff_size>(m_contentLength));
+    m_buffer->resize(static_cast<size_t>(m_contentLength));
+    m_filled = 0;
+    return this->yieldTo(&AlignedBodyReader::readBody);
+  }
+
+  Action readBody() {
+    Action action;
+    auto res = m_stream->read(m_buffer->data() + m_filled, static_cast<v_buff_size>(m_buffer->size()) - m_filled, action);
+    if (!action.isNone()) {
+      return action;
+    }
+    if (res > 0) {
+      m_filled += res;
+      if (m_filled == static_cast<v_buff_size>(m_buffer->size())) {
+        return this->yieldTo(&AlignedBodyReader::onBody);
+      }
+      return this->repeat();
+    }
+    if (res == oatpp::IOError::RETRY_READ || res == oatpp::IOError::RETRY_WRITE) {
+      return this->repeat();
+    }
+    if (res == 0 || res == oatpp::IOError::ZERO_VALUE) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::AlignedBodyReader::readBody()]: Truncated body");
+    }
+    return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::AlignedBodyReader::readBody()]: Stream read error");
+  }
+
+  Action onBody() {
+    ContentEncoding::Codec codec;
+    ContentEncoding::parse(m_contentEncoding, codec);
+    if (codec != ContentEncoding::Codec::IDENTITY) {
+      m_buffer = ContentEncoding::decode(codec, m_buffer->data(), static_cast<v_buff_size>(m_buffer->size()), m_maxBodySize);
+      if (!m_buffer) {
+        return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::AlignedBodyReader::onBody()]: Failed to decode body");
+      }
+    }
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = m_mapper->readFromBuffer(m_buffer, Object<T>::Class::getType(), errorStack, m_arena);
+    m_buffer = nullptr;
+    if (!errorStack.empty() || !value) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::AlignedBodyReader::onBody()]: Failed to map body");
+    }
+    return m_callback(value.template cast<Object<T>>()).next(this->finish());
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_ALIGNED_BODY_READER_HPP */
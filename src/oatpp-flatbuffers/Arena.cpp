@@ -0,0 +1,118 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Arena.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+constexpr v_buff_size BLOCK_HEADER_SIZE = Arena::ALIGNMENT;
+
+}
+
+Arena::FlatBuffersAllocator::FlatBuffersAllocator(Arena* arena)
+  : m_arena(arena)
+{}
+
+uint8_t* Arena::FlatBuffersAllocator::allocate(size_t size) {
+  return static_cast<uint8_t*>(m_arena->allocate(static_cast<v_buff_size>(size)));
+}
+
+void Arena::FlatBuffersAllocator::deallocate(uint8_t* p, size_t size) {
+  (void) p;
+  (void) size;
+}
+
+Arena::Arena(v_buff_size blockSize)
+  : m_blockSize(blockSize > 0 ? blockSize : DEFAULT_BLOCK_SIZE)
+  , m_flatBuffersAllocator(this)
+{}
+
+Arena::~Arena() {
+  Block* block = m_blocks;
+  while (block) {
+    Block* next = block->next;
+    ::operator delete(block, std::align_val_t(ALIGNMENT));
+    block = next;
+  }
+}
+
+std::shared_ptr<Arena> Arena::createShared(v_buff_size blockSize) {
+  return std::make_shared<Arena>(blockSize);
+}
+
+uint8_t* Arena::allocateBlock(v_buff_size dataSize) {
+  auto* p = static_cast<uint8_t*>(::operator new(static_cast<size_t>(BLOCK_HEADER_SIZE + dataSize), std::align_val_t(ALIGNMENT)));
+  auto* block = reinterpret_cast<Block*>(p);
+  block->next = m_blocks;
+  m_blocks = block;
+  m_reservedBytes += BLOCK_HEADER_SIZE + dataSize;
+  return p + BLOCK_HEADER_SIZE;
+}
+
+void* Arena::allocate(v_buff_size size, v_buff_size alignment) {
+  if (size <= 0) size = 1;
+  if (alignment <= 0 || alignment > ALIGNMENT) alignment = ALIGNMENT;
+  m_usedBytes += size;
+  // 大块单独分配，不打断当前块的游标
+  if (size > m_blockSize / 2) {
+    return allocateBlock(size);
+  }
+  auto mask = static_cast<uintptr_t>(alignment - 1);
+  auto aligned = (reinterpret_cast<uintptr_t>(m_cursor) + mask) & ~mask;
+  if (!m_cursor || aligned + static_cast<uintptr_t>(size) > reinterpret_cast<uintptr_t>(m_end)) {
+    m_cursor = allocateBlock(m_blockSize);
+    m_end = m_cursor + m_blockSize;
+    aligned = reinterpret_cast<uintptr_t>(m_cursor);
+  }
+  m_cursor = reinterpret_cast<uint8_t*>(aligned + static_cast<uintptr_t>(size));
+  return reinterpret_cast<void*>(aligned);
+}
+
+uint8_t* Arena::copy(const uint8_t* data, v_buff_size size) {
+  auto* p = static_cast<uint8_t*>(allocate(size));
+  std::memcpy(p, data, static_cast<size_t>(size));
+  return p;
+}
+
+::flatbuffers::Allocator* Arena::getFlatBuffersAllocator() {
+  return &m_flatBuffersAllocator;
+}
+
+v_buff_size Arena::getReservedBytes() const {
+  return m_reservedBytes;
+}
+
+v_buff_size Arena::getUsedBytes() const {
+  return m_usedBytes;
+}
+
+}}
@@ -0,0 +1,158 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef OATPP_FLATBUFFERS_ARENA_HPP
+#define OATPP_FLATBUFFERS_ARENA_HPP
+
+#include "oatpp/Types.hpp"
+
+#include "flatbuffers/flatbuffers.h"
+
+#include <memory>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 按请求划分的 bump-pointer 内存区。
+ * - 分配只移动游标，单个释放是空操作；Arena 析构时一次性归还所有块。
+ * - 通过 `createShared()` 创建；从 Arena 构造的 `Object<T>` 持有 Arena 的引用，
+ *   所以最后一个 `Object<T>`（以及请求协程本身）释放后整块内存才被回收。
+ * - 分配不加锁：同一时刻只应有一个执行流在分配（一个异步协程正好满足）。
+ *   释放可以发生在任何线程。
+ * - 不绑定线程：作为协程成员显式传给 builder 与读取接口（`ObjectMapper::read(caret, type, arena, errorStack)`、
+ *   `RequestBodyReader` 等），协程跨 yield、换执行线程后仍可继续使用。
+ */
+class Arena {
+public:
+  static constexpr v_buff_size DEFAULT_BLOCK_SIZE = 16 * 1024;
+  static constexpr v_buff_size ALIGNMENT = 16;
+public:
+
+  /**
+   * 供 `::flatbuffers::FlatBufferBuilder` 使用的分配器，内存来自所属 Arena。
+   * builder 不得比 Arena 活得更久。
+   */
+  class FlatBuffersAllocator : public ::flatbuffers::Allocator {
+  private:
+    Arena* m_arena;
+  public:
+    explicit FlatBuffersAllocator(Arena* arena);
+    uint8_t* allocate(size_t size) override;
+    void deallocate(uint8_t* p, size_t size) override;
+  };
+
+private:
+  struct Block {
+    Block* next;
+  };
+private:
+  v_buff_size m_blockSize;
+  Block* m_blocks = nullptr;
+  uint8_t* m_cursor = nullptr;
+  uint8_t* m_end = nullptr;
+  v_buff_size m_reservedBytes = 0;
+  v_buff_size m_usedBytes = 0;
+  FlatBuffersAllocator m_flatBuffersAllocator;
+private:
+  uint8_t* allocateBlock(v_buff_size dataSize);
+public:
+
+  /**
+   * Constructor.
+   * @param blockSize - 常规块大小；超过半块的分配单独成块。
+   */
+  explicit Arena(v_buff_size blockSize = DEFAULT_BLOCK_SIZE);
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  static std::shared_ptr<Arena> createShared(v_buff_size blockSize = DEFAULT_BLOCK_SIZE);
+
+  /**
+   * 分配 `size` 字节，按 `alignment`（2 的幂，不超过 ALIGNMENT）对齐。
+   */
+  void* allocate(v_buff_size size, v_buff_size alignment = ALIGNMENT);
+
+  /**
+   * 拷贝 [data, data + size) 到 Arena 中。
+   */
+  uint8_t* copy(const uint8_t* data, v_buff_size size);
+
+  /**
+   * 传给 `FlatBufferBuilder(initialSize, arena->getFlatBuffersAllocator())`。
+   */
+  ::flatbuffers::Allocator* getFlatBuffersAllocator();
+
+  /**
+   * 已向系统申请的字节数（含未用完的块尾）。
+   */
+  v_buff_size getReservedBytes() const;
+
+  /**
+   * 已分配出去的字节数。
+   */
+  v_buff_size getUsedBytes() const;
+
+};
+
+/**
+ * 供 std::allocate_shared 使用的 STL 分配器：控制块与对象放在 Arena 中，
+ * 并持有 Arena 的引用，保证对象存活期间 Arena 不被释放。
+ */
+template<typename U>
+class ArenaStlAllocator {
+public:
+  using value_type = U;
+public:
+  std::shared_ptr<Arena> arena;
+public:
+  explicit ArenaStlAllocator(std::shared_ptr<Arena> a)
+    : arena(std::move(a))
+  {}
+  template<typename V>
+  ArenaStlAllocator(const ArenaStlAllocator<V>& other)
+    : arena(other.arena)
+  {}
+  U* allocate(size_t n) {
+    static_assert(alignof(U) <= Arena::ALIGNMENT, "Over-aligned types are not supported by Arena");
+    return static_cast<U*>(arena->allocate(static_cast<v_buff_size>(sizeof(U) * n), alignof(U)));
+  }
+  void deallocate(U*, size_t) {
+    // 随 Arena 一起释放
+  }
+  template<typename V>
+  bool operator==(const ArenaStlAllocator<V>& other) const {
+    return arena == other.arena;
+  }
+  template<typename V>
+  bool operator!=(const ArenaStlAllocator<V>& other) const {
+    return !(*this == other);
+  }
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_ARENA_HPP */
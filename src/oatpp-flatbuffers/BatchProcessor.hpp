@@ -0,0 +1,216 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_BATCH_PROCESSOR_HPP
+#define OATPP_FLATBUFFERS_BATCH_PROCESSOR_HPP
+
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/async/Coroutine.hpp"
+#include "oatpp/async/CoroutineWaitList.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/Types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 批量处理：把 ObjectMapper 读出的一批 `Object<T>`（同一 body 上的 size-prefixed 帧，校验已延迟）
+ * 按连续区间切成若干块，交给 Executor 的多个工作线程并行完成「校验 + handler」，结果按原顺序收集。
+ *
+ * - 每项结果独立：校验失败或 handler 抛异常只记在该项的 `Result`，不影响其它项；
+ * - handler 在 Executor 的处理线程上同步运行，适合 CPU 密集的逐项处理，不应阻塞 I/O；
+ * - 调用方协程等待全部块完成后拿到结果，期间不占用处理线程。
+ *
+ * @tparam T - FlatBuffers 生成的 Table 类型
+ * @tparam R - 每项的处理结果类型（需可默认构造）
+ */
+template<typename T, typename R>
+class BatchProcessor {
+public:
+  using Handler = std::function<R(const Object<T>&)>;
+
+  /**
+   * 单项结果。`ok == false` 时 `error` 给出原因。
+   */
+  struct Result {
+    bool ok = false;
+    R value {};
+    std::string error;
+  };
+
+  using Results = std::vector<Result>;
+private:
+
+  /*
+   * Join 检查 remaining 与挂入 waitList 之间，最后一个 Chunk 可能已经 notifyAll 过了。
+   * 做法与 oatpp::async::Lock 相同：State 作为 waitList 的 Listener，
+   * 每挂入一个协程就重查一次 remaining，已归零则立即唤醒，不再需要超时轮询。
+   */
+  struct State : public oatpp::async::CoroutineWaitList::Listener {
+    std::vector<Object<T>> items;
+    Handler handler;
+    std::shared_ptr<Results> results;
+    std::atomic<v_int64> remaining {0};
+    oatpp::async::CoroutineWaitList waitList;
+
+    State() {
+      waitList.setListener(this);
+    }
+
+    void onNewItem(oatpp::async::CoroutineWaitList& list) override {
+      if (remaining.load(std::memory_order_acquire) == 0) {
+        list.notifyAll();
+      }
+    }
+  };
+
+  class Chunk : public oatpp::async::Coroutine<Chunk> {
+  private:
+    std::shared_ptr<State> m_state;
+    size_t m_begin;
+    size_t m_end;
+  public:
+    Chunk(const std::shared_ptr<State>& state, size_t begin, size_t end)
+      : m_state(state)
+      , m_begin(begin)
+      , m_end(end)
+    {}
+
+    oatpp::async::Action act() override {
+      processRange(m_state->items, m_state->handler, *m_state->results, m_begin, m_end);
+      if (m_state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_state->waitList.notifyAll();
+      }
+      return this->finish();
+    }
+  };
+
+  class Join : public oatpp::async::CoroutineWithResult<Join, const std::shared_ptr<Results>&> {
+  private:
+    std::shared_ptr<State> m_state;
+  public:
+    explicit Join(const std::shared_ptr<State>& state)
+      : m_state(state)
+    {}
+
+    oatpp::async::Action act() override {
+      if (m_state->remaining.load(std::memory_order_acquire) == 0) {
+        return this->_return(m_state->results);
+      }
+      return oatpp::async::Action::createWaitListAction(&m_state->waitList);
+    }
+  };
+
+public:
+
+  /**
+   * 处理 [begin, end) 区间，结果写入 `results` 的对应位置。
+   */
+  static void processRange(const std::vector<Object<T>>& items,
+                           const Handler& handler,
+                           Results& results,
+                           size_t begin,
+                           size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      auto& result = results[i];
+      const auto& item = items[i];
+      if (!item || !item.get()->ensureVerified()) {
+        result.error = "FlatBuffers verification failed";
+        continue;
+      }
+      try {
+        result.value = handler(item);
+        result.ok = true;
+      } catch (const std::exception& e) {
+        result.error = e.what();
+      } catch (...) {
+        result.error = "Unknown error";
+      }
+    }
+  }
+
+  /**
+   * 在当前线程顺序处理整批（无 Executor 时或批很小时使用）。
+   */
+  static std::shared_ptr<Results> process(const std::vector<Object<T>>& items, const Handler& handler) {
+    auto results = std::make_shared<Results>(items.size());
+    processRange(items, handler, *results, 0, items.size());
+    return results;
+  }
+
+  /**
+   * 并行处理整批。
+   * @param executor - 承载工作块的 Executor（通常即 HTTP 服务所用的那个）。
+   * @param items - 待处理对象，例如 `readBodyToDtoAsync<oatpp::List<Object<T>>>` 的结果。
+   * @param handler - 逐项处理函数，可能在多个线程上并发调用。
+   * @param parallelism - 最多切成多少块；0 表示 `std::thread::hardware_concurrency()`。
+   * @param minChunkSize - 每块至少包含的项数，避免小批被切得过碎。
+   * @return - 按输入顺序排列的结果。
+   */
+  static oatpp::async::CoroutineStarterForResult<const std::shared_ptr<Results>&>
+  processAsync(const std::shared_ptr<oatpp::async::Executor>& executor,
+               const oatpp::List<Object<T>>& items,
+               const Handler& handler,
+               v_int32 parallelism = 0,
+               v_buff_size minChunkSize = 16) {
+    auto state = std::make_shared<State>();
+    if (items) {
+      state->items.assign(items->begin(), items->end());
+    }
+    state->handler = handler;
+    state->results = std::make_shared<Results>(state->items.size());
+
+    size_t count = state->items.size();
+    size_t workers = parallelism > 0 ? static_cast<size_t>(parallelism) : std::max<size_t>(1, std::thread::hardware_concurrency());
+    workers = std::min(workers, (count + static_cast<size_t>(std::max<v_buff_size>(1, minChunkSize)) - 1) /
+                                static_cast<size_t>(std::max<v_buff_size>(1, minChunkSize)));
+
+    if (workers <= 1 || !executor) {
+      processRange(state->items, state->handler, *state->results, 0, count);
+    } else {
+      state->remaining.store(static_cast<v_int64>(workers), std::memory_order_release);
+      size_t begin = 0;
+      for (size_t w = 0; w < workers; ++w) {
+        size_t end = begin + (count - begin) / (workers - w);
+        executor->execute<Chunk>(state, begin, end);
+        begin = end;
+      }
+    }
+    return Join::startForResult(state);
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_BATCH_PROCESSOR_HPP */
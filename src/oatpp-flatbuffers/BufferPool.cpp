@@ -0,0 +1,172 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BufferPool.hpp"
+
+#include <algorithm>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+// 每级缓存上限按字节预算折算：小缓冲多留，大缓冲少留
+constexpr v_buff_size THREAD_CACHE_BYTES = 1024 * 1024;
+constexpr v_buff_size SHARED_CACHE_BYTES = 16 * 1024 * 1024;
+constexpr v_buff_size THREAD_CACHE_MAX_COUNT = 8;
+constexpr v_buff_size SHARED_CACHE_MAX_COUNT = 64;
+
+v_buff_size cacheLimit(v_int32 classIndex, v_buff_size budget, v_buff_size maxCount) {
+  v_buff_size classSize = v_buff_size(1) << (classIndex + BufferPool::MIN_CLASS_SHIFT);
+  return std::min<v_buff_size>(maxCount, std::max<v_buff_size>(1, budget / classSize));
+}
+
+struct ThreadCache {
+  std::vector<std::vector<uint8_t>*> classes[BufferPool::CLASS_COUNT];
+  ~ThreadCache() {
+    for (v_int32 i = 0; i < BufferPool::CLASS_COUNT; ++i) {
+      for (auto* buffer : classes[i]) {
+        BufferPool::instance().releaseToShared(buffer, i);
+      }
+    }
+  }
+};
+
+thread_local ThreadCache t_cache;
+
+}
+
+BufferPool::~BufferPool() {
+  for (auto& shared : m_shared) {
+    for (auto* buffer : shared.buffers) {
+      delete buffer;
+    }
+    shared.buffers.clear();
+  }
+}
+
+BufferPool& BufferPool::instance() {
+  static BufferPool pool;
+  return pool;
+}
+
+v_int32 BufferPool::getClassIndex(v_buff_size size) {
+  v_int32 shift = MIN_CLASS_SHIFT;
+  while (shift <= MAX_CLASS_SHIFT && (v_buff_size(1) << shift) < size) {
+    ++shift;
+  }
+  if (shift > MAX_CLASS_SHIFT) return -1;
+  return shift - MIN_CLASS_SHIFT;
+}
+
+std::vector<uint8_t>* BufferPool::take(v_int32 classIndex) {
+  auto& local = t_cache.classes[classIndex];
+  if (!local.empty()) {
+    auto* buffer = local.back();
+    local.pop_back();
+    return buffer;
+  }
+  auto& shared = m_shared[classIndex];
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  if (!shared.buffers.empty()) {
+    auto* buffer = shared.buffers.back();
+    shared.buffers.pop_back();
+    return buffer;
+  }
+  return nullptr;
+}
+
+void BufferPool::release(std::vector<uint8_t>* buffer) {
+  // 按实际容量向下取级：容量为 c 的缓冲可满足 <= 2^floor(log2 c) 的请求
+  v_buff_size capacity = static_cast<v_buff_size>(buffer->capacity());
+  v_int32 shift = MIN_CLASS_SHIFT;
+  if (capacity < (v_buff_size(1) << shift) || capacity >= (v_buff_size(1) << (MAX_CLASS_SHIFT + 1))) {
+    delete buffer;
+    m_discarded.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  while (shift < MAX_CLASS_SHIFT && (v_buff_size(1) << (shift + 1)) <= capacity) {
+    ++shift;
+  }
+  v_int32 classIndex = shift - MIN_CLASS_SHIFT;
+  buffer->clear();
+  auto& local = t_cache.classes[classIndex];
+  if (static_cast<v_buff_size>(local.size()) < cacheLimit(classIndex, THREAD_CACHE_BYTES, THREAD_CACHE_MAX_COUNT)) {
+    local.push_back(buffer);
+    m_recycled.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  releaseToShared(buffer, classIndex);
+}
+
+void BufferPool::releaseToShared(std::vector<uint8_t>* buffer, v_int32 classIndex) {
+  auto& shared = m_shared[classIndex];
+  {
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (static_cast<v_buff_size>(shared.buffers.size()) < cacheLimit(classIndex, SHARED_CACHE_BYTES, SHARED_CACHE_MAX_COUNT)) {
+      shared.buffers.push_back(buffer);
+      m_recycled.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  delete buffer;
+  m_discarded.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<std::vector<uint8_t>> BufferPool::acquire(v_buff_size capacity) {
+  v_int32 classIndex = getClassIndex(capacity);
+  if (classIndex < 0) {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    buffer->reserve(static_cast<size_t>(capacity));
+    return buffer;
+  }
+  auto* buffer = take(classIndex);
+  if (buffer) {
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    buffer = new std::vector<uint8_t>();
+    buffer->reserve(size_t(1) << (classIndex + MIN_CLASS_SHIFT));
+  }
+  return std::shared_ptr<std::vector<uint8_t>>(buffer, [](std::vector<uint8_t>* b) {
+    BufferPool::instance().release(b);
+  });
+}
+
+std::shared_ptr<const std::vector<uint8_t>> BufferPool::copyOf(const uint8_t* data, v_buff_size size) {
+  auto buffer = acquire(size);
+  buffer->insert(buffer->end(), data, data + size);
+  return buffer;
+}
+
+BufferPool::Statistics BufferPool::getStatistics() const {
+  Statistics stats;
+  stats.hits = m_hits.load(std::memory_order_relaxed);
+  stats.misses = m_misses.load(std::memory_order_relaxed);
+  stats.recycled = m_recycled.load(std::memory_order_relaxed);
+  stats.discarded = m_discarded.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}}
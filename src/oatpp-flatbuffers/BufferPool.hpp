@@ -0,0 +1,111 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_BUFFER_POOL_HPP
+#define OATPP_FLATBUFFERS_BUFFER_POOL_HPP
+
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 按容量分级（2 的幂，256B ~ 16MB）的字节缓冲池，供 ObjectMapper::read 的拷贝路径复用。
+ * - 每个线程有本地缓存，命中时无锁；本地缓存满/空时退回到带锁的共享缓存。
+ * - 池化缓冲以 `std::shared_ptr<std::vector<uint8_t>>` 形式交出，最后一个引用
+ *   （通常是最后一个 `Object<T>`）释放时，vector 连同容量回到池中。
+ * - 超过最大级别的请求不入池，按普通 vector 分配。
+ */
+class BufferPool {
+public:
+  static constexpr v_int32 MIN_CLASS_SHIFT = 8;
+  static constexpr v_int32 MAX_CLASS_SHIFT = 24;
+  static constexpr v_int32 CLASS_COUNT = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+
+  /**
+   * 命中/未命中统计。
+   */
+  struct Statistics {
+    v_int64 hits = 0;
+    v_int64 misses = 0;
+    v_int64 recycled = 0;
+    v_int64 discarded = 0;
+  };
+
+private:
+  struct SharedClass {
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>*> buffers;
+  };
+private:
+  SharedClass m_shared[CLASS_COUNT];
+  std::atomic<v_int64> m_hits {0};
+  std::atomic<v_int64> m_misses {0};
+  std::atomic<v_int64> m_recycled {0};
+  std::atomic<v_int64> m_discarded {0};
+private:
+  BufferPool() = default;
+  std::vector<uint8_t>* take(v_int32 classIndex);
+  void release(std::vector<uint8_t>* buffer);
+public:
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+  ~BufferPool();
+
+  static BufferPool& instance();
+
+  /**
+   * 级别索引；超出最大级别返回 -1。
+   */
+  static v_int32 getClassIndex(v_buff_size size);
+
+  /**
+   * 取一个空的、容量至少为 `capacity` 的缓冲。
+   */
+  std::shared_ptr<std::vector<uint8_t>> acquire(v_buff_size capacity);
+
+  /**
+   * 取一个池化缓冲并拷入 [data, data + size)（不做零初始化）。
+   */
+  std::shared_ptr<const std::vector<uint8_t>> copyOf(const uint8_t* data, v_buff_size size);
+
+  /**
+   * 当前统计快照。
+   */
+  Statistics getStatistics() const;
+
+  /**
+   * 线程退出时归还本地缓存（内部使用）。
+   */
+  void releaseToShared(std::vector<uint8_t>* buffer, v_int32 classIndex);
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_BUFFER_POOL_HPP */
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BuilderPool.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+struct ThreadCache {
+  std::vector<std::unique_ptr<::flatbuffers::FlatBufferBuilder>> builders;
+  v_buff_size bytes = 0;
+};
+
+thread_local ThreadCache t_cache;
+
+}
+
+BuilderPool& BuilderPool::instance() {
+  static BuilderPool pool;
+  return pool;
+}
+
+std::shared_ptr<::flatbuffers::FlatBufferBuilder> BuilderPool::acquire(v_buff_size initialSize) {
+  ::flatbuffers::FlatBufferBuilder* builder = nullptr;
+  auto& cache = t_cache.builders;
+  if (!cache.empty()) {
+    builder = cache.back().release();
+    cache.pop_back();
+    t_cache.bytes -= static_cast<v_buff_size>(builder->GetBufferCapacity());
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    builder = new ::flatbuffers::FlatBufferBuilder(static_cast<size_t>(initialSize));
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+  }
+  return std::shared_ptr<::flatbuffers::FlatBufferBuilder>(builder, [](::flatbuffers::FlatBufferBuilder* b) {
+    BuilderPool::instance().release(b);
+  });
+}
+
+void BuilderPool::release(::flatbuffers::FlatBufferBuilder* builder) {
+  auto& cache = t_cache.builders;
+  v_buff_size capacity = static_cast<v_buff_size>(builder->GetBufferCapacity());
+  if (capacity <= MAX_RETAINED_CAPACITY &&
+      t_cache.bytes + capacity <= THREAD_CACHE_BYTES &&
+      static_cast<v_int32>(cache.size()) < THREAD_CACHE_SIZE) {
+    builder->Clear();
+    cache.emplace_back(builder);
+    t_cache.bytes += capacity;
+    m_recycled.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  delete builder;
+  m_discarded.fetch_add(1, std::memory_order_relaxed);
+}
+
+BuilderPool::Statistics BuilderPool::getStatistics() const {
+  Statistics stats;
+  stats.hits = m_hits.load(std::memory_order_relaxed);
+  stats.misses = m_misses.load(std::memory_order_relaxed);
+  stats.recycled = m_recycled.load(std::memory_order_relaxed);
+  stats.discarded = m_discarded.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_BUILDER_POOL_HPP
+#define OATPP_FLATBUFFERS_BUILDER_POOL_HPP
+
+#include "oatpp/Types.hpp"
+
+#include "flatbuffers/flatbuffers.h"
+
+#include <atomic>
+#include <memory>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 线程本地的 FlatBufferBuilder 池。
+ * - `acquire()` 优先取当前线程缓存中的 builder，已分配的内部缓冲被保留（只做 Clear()）。
+ * - 返回的 `std::shared_ptr` 释放时，builder 被 Clear() 后放回释放线程的缓存；缓存满则销毁。
+ * - Clear() 不释放内部缓冲，偶发的大消息会让 builder 一直占着峰值容量：容量超过
+ *   `MAX_RETAINED_CAPACITY` 的 builder 直接销毁，每线程缓存的总容量不超过 `THREAD_CACHE_BYTES`。
+ * - Finish() 后可通过 `Object<T>::fromPooledBuilder()` 直接把输出包装为 `Object<T>`，
+ *   最后一个引用释放时 builder 连同内存回到池中。
+ */
+class BuilderPool {
+public:
+
+  /**
+   * 命中/未命中统计。
+   */
+  struct Statistics {
+    v_int64 hits = 0;
+    v_int64 misses = 0;
+    v_int64 recycled = 0;
+    v_int64 discarded = 0;
+  };
+
+public:
+  static constexpr v_buff_size DEFAULT_INITIAL_SIZE = 1024;
+  static constexpr v_int32 THREAD_CACHE_SIZE = 16;
+  static constexpr v_buff_size MAX_RETAINED_CAPACITY = 1024 * 1024;
+  static constexpr v_buff_size THREAD_CACHE_BYTES = 4 * 1024 * 1024;
+private:
+  std::atomic<v_int64> m_hits {0};
+  std::atomic<v_int64> m_misses {0};
+  std::atomic<v_int64> m_recycled {0};
+  std::atomic<v_int64> m_discarded {0};
+private:
+  BuilderPool() = default;
+  void release(::flatbuffers::FlatBufferBuilder* builder);
+public:
+  BuilderPool(const BuilderPool&) = delete;
+  BuilderPool& operator=(const BuilderPool&) = delete;
+
+  static BuilderPool& instance();
+
+  /**
+   * 取一个已清空的 builder。
+   * @param initialSize - 需要新建时的初始容量。
+   */
+  std::shared_ptr<::flatbuffers::FlatBufferBuilder> acquire(v_buff_size initialSize = DEFAULT_INITIAL_SIZE);
+
+  /**
+   * 当前统计快照。
+   */
+  Statistics getStatistics() const;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_BUILDER_POOL_HPP */
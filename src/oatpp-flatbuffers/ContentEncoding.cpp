@@ -0,0 +1,398 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ContentEncoding.hpp"
+#include "BufferPool.hpp"
+#include "ZstdDictionary.hpp"
+
+#ifdef OATPP_FLATBUFFERS_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_LZ4
+#include <lz4frame.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+std::string trimLower(const char* begin, const char* end) {
+  while (begin < end && std::isspace(static_cast<unsigned char>(*begin))) ++begin;
+  while (end > begin && std::isspace(static_cast<unsigned char>(end[-1]))) --end;
+  std::string result(begin, end);
+  for (auto& c : result) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return result;
+}
+
+bool parseToken(const std::string& token, ContentEncoding::Codec& codec) {
+  if (token.empty() || token == "identity") {
+    codec = ContentEncoding::Codec::IDENTITY;
+  } else if (token == "gzip" || token == "x-gzip") {
+    codec = ContentEncoding::Codec::GZIP;
+  } else if (token == "zstd") {
+    codec = ContentEncoding::Codec::ZSTD;
+  } else if (token == "lz4" || token == "x-lz4") {
+    codec = ContentEncoding::Codec::LZ4;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<std::vector<uint8_t>> acquireSized(v_buff_size size) {
+  auto buffer = BufferPool::instance().acquire(size);
+  buffer->resize(static_cast<size_t>(size));
+  return buffer;
+}
+
+// 初始分配不超过输入的这个倍数；声明的原始长度来自对端，不可信，更大的输出靠 grow() 按实际数据扩容
+constexpr v_int64 MAX_INITIAL_RATIO = 8;
+
+// 解码输出的初始大小：已知原始长度时取它与输入 8 倍中的较小者，否则按输入的 4 倍估计
+v_buff_size initialDecodedSize(v_int64 hint, v_buff_size inputSize, v_buff_size maxSize) {
+  v_int64 cap = std::max<v_int64>(256, static_cast<v_int64>(inputSize) * MAX_INITIAL_RATIO);
+  v_int64 size = hint > 0 ? std::min<v_int64>(hint, cap) : std::max<v_int64>(256, static_cast<v_int64>(inputSize) * 4);
+  return static_cast<v_buff_size>(std::min<v_int64>(size, maxSize));
+}
+
+// 输出缓冲翻倍（不超过上限）；已达上限返回 false
+bool grow(std::vector<uint8_t>& out, v_buff_size maxSize) {
+  v_buff_size current = static_cast<v_buff_size>(out.size());
+  if (current >= maxSize) return false;
+  out.resize(static_cast<size_t>(std::min<v_buff_size>(maxSize, std::max<v_buff_size>(256, current * 2))));
+  return true;
+}
+
+#ifdef OATPP_FLATBUFFERS_WITH_ZLIB
+
+std::shared_ptr<std::vector<uint8_t>> gzipEncode(const uint8_t* data, v_buff_size size, v_int32 level) {
+  z_stream zs;
+  std::memset(&zs, 0, sizeof(zs));
+  // windowBits + 16：写 gzip 头尾而不是 zlib 头
+  if (deflateInit2(&zs, level > 0 ? level : Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return nullptr;
+  }
+  auto out = acquireSized(static_cast<v_buff_size>(deflateBound(&zs, static_cast<uLong>(size))));
+  zs.next_in = const_cast<Bytef*>(data);
+  zs.avail_in = static_cast<uInt>(size);
+  zs.next_out = out->data();
+  zs.avail_out = static_cast<uInt>(out->size());
+  int rc = deflate(&zs, Z_FINISH);
+  out->resize(static_cast<size_t>(zs.total_out));
+  deflateEnd(&zs);
+  return rc == Z_STREAM_END ? out : nullptr;
+}
+
+std::shared_ptr<std::vector<uint8_t>> gzipDecode(const uint8_t* data, v_buff_size size, v_buff_size maxSize) {
+  z_stream zs;
+  std::memset(&zs, 0, sizeof(zs));
+  if (inflateInit2(&zs, 15 + 16) != Z_OK) {
+    return nullptr;
+  }
+  // gzip 尾部 ISIZE 为原始长度（mod 2^32），单成员时即精确长度
+  v_int64 hint = -1;
+  if (size >= 18) {
+    const uint8_t* tail = data + size - 4;
+    hint = static_cast<v_int64>(tail[0]) | (static_cast<v_int64>(tail[1]) << 8) |
+           (static_cast<v_int64>(tail[2]) << 16) | (static_cast<v_int64>(tail[3]) << 24);
+  }
+  auto out = acquireSized(initialDecodedSize(hint, size, maxSize));
+  zs.next_in = const_cast<Bytef*>(data);
+  zs.avail_in = static_cast<uInt>(size);
+  int rc;
+  while (true) {
+    zs.next_out = out->data() + zs.total_out;
+    zs.avail_out = static_cast<uInt>(out->size() - zs.total_out);
+    rc = inflate(&zs, Z_NO_FLUSH);
+    if (rc == Z_STREAM_END) break;
+    if (rc != Z_OK && rc != Z_BUF_ERROR) break;
+    if (zs.avail_out == 0) {
+      if (!grow(*out, maxSize)) {
+        rc = Z_MEM_ERROR;
+        break;
+      }
+    } else if (zs.avail_in == 0) {
+      rc = Z_DATA_ERROR;
+      break;
+    }
+  }
+  auto produced = zs.total_out;
+  inflateEnd(&zs);
+  if (rc != Z_STREAM_END || zs.avail_in != 0) return nullptr;
+  out->resize(static_cast<size_t>(produced));
+  return out;
+}
+
+#endif
+
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+
+// 上下文按线程复用，避免每条消息重新分配窗口
+ZSTD_CCtx* threadCCtx() {
+  thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> ctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+  return ctx.get();
+}
+
+ZSTD_DCtx* threadDCtx() {
+  thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> ctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+  return ctx.get();
+}
+
+std::shared_ptr<std::vector<uint8_t>> zstdEncode(const uint8_t* data, v_buff_size size, v_int32 level) {
+  auto out = acquireSized(static_cast<v_buff_size>(ZSTD_compressBound(static_cast<size_t>(size))));
+  // 单次压缩默认写入 frame content size，解码端可一次分配到位；3 为 zstd 默认级别
+  size_t n = ZSTD_compressCCtx(threadCCtx(), out->data(), out->size(), data, static_cast<size_t>(size), level > 0 ? level : 3);
+  if (ZSTD_isError(n)) return nullptr;
+  out->resize(n);
+  return out;
+}
+
+std::shared_ptr<std::vector<uint8_t>> zstdDecode(const uint8_t* data, v_buff_size size, v_buff_size maxSize) {
+  auto dctx = threadDCtx();
+  // 上一次流式解码可能引用过字典，先清掉
+  ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+  // 帧头带 dictID 时用已登记的字典解码；本端未加载该字典则无法解码
+  std::shared_ptr<ZstdDictionary> dictionary;
+  const ZSTD_DDict* ddict = nullptr;
+  unsigned dictId = ZSTD_getDictID_fromFrame(data, static_cast<size_t>(size));
+  if (dictId != 0) {
+    dictionary = ZstdDictionaryRegistry::instance().findById(dictId);
+    if (!dictionary) return nullptr;
+    ddict = dictionary->getDDict();
+  }
+  unsigned long long known = ZSTD_getFrameContentSize(data, static_cast<size_t>(size));
+  if (known == ZSTD_CONTENTSIZE_ERROR) return nullptr;
+  if (known != ZSTD_CONTENTSIZE_UNKNOWN && known > static_cast<unsigned long long>(maxSize)) return nullptr;
+  // 声明长度在初始上限内才一次解到位，否则走流式解码边解边扩容
+  if (known != ZSTD_CONTENTSIZE_UNKNOWN &&
+      static_cast<v_buff_size>(known) == initialDecodedSize(static_cast<v_int64>(known), size, maxSize)) {
+    auto out = acquireSized(static_cast<v_buff_size>(known));
+    size_t n = ddict ? ZSTD_decompress_usingDDict(dctx, out->data(), out->size(), data, static_cast<size_t>(size), ddict)
+                     : ZSTD_decompressDCtx(dctx, out->data(), out->size(), data, static_cast<size_t>(size));
+    if (!ZSTD_isError(n) && n == known) return out;
+    // 多帧拼接时首帧长度不代表总长，退回流式解码
+  }
+  ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+  if (ddict) {
+    ZSTD_DCtx_refDDict(dctx, ddict);
+  }
+  auto out = acquireSized(initialDecodedSize(known == ZSTD_CONTENTSIZE_UNKNOWN ? -1 : static_cast<v_int64>(known), size, maxSize));
+  ZSTD_inBuffer in {data, static_cast<size_t>(size), 0};
+  size_t produced = 0;
+  while (true) {
+    ZSTD_outBuffer ob {out->data(), out->size(), produced};
+    size_t rc = ZSTD_decompressStream(dctx, &ob, &in);
+    produced = ob.pos;
+    if (ZSTD_isError(rc)) return nullptr;
+    if (rc == 0 && in.pos == in.size) break;
+    if (ob.pos == ob.size) {
+      if (!grow(*out, maxSize)) return nullptr;
+    } else if (in.pos == in.size) {
+      return nullptr;
+    }
+  }
+  out->resize(produced);
+  return out;
+}
+
+#endif
+
+#ifdef OATPP_FLATBUFFERS_WITH_LZ4
+
+std::shared_ptr<std::vector<uint8_t>> lz4Encode(const uint8_t* data, v_buff_size size, v_int32 level) {
+  LZ4F_preferences_t prefs;
+  std::memset(&prefs, 0, sizeof(prefs));
+  prefs.frameInfo.contentSize = static_cast<unsigned long long>(size);
+  prefs.compressionLevel = level;
+  auto out = acquireSized(static_cast<v_buff_size>(LZ4F_compressFrameBound(static_cast<size_t>(size), &prefs)));
+  size_t n = LZ4F_compressFrame(out->data(), out->size(), data, static_cast<size_t>(size), &prefs);
+  if (LZ4F_isError(n)) return nullptr;
+  out->resize(n);
+  return out;
+}
+
+std::shared_ptr<std::vector<uint8_t>> lz4Decode(const uint8_t* data, v_buff_size size, v_buff_size maxSize) {
+  LZ4F_dctx* raw = nullptr;
+  if (LZ4F_isError(LZ4F_createDecompressionContext(&raw, LZ4F_VERSION))) return nullptr;
+  std::unique_ptr<LZ4F_dctx, LZ4F_errorCode_t (*)(LZ4F_dctx*)> dctx(raw, LZ4F_freeDecompressionContext);
+
+  LZ4F_frameInfo_t info;
+  std::memset(&info, 0, sizeof(info));
+  size_t inPos = static_cast<size_t>(size);
+  if (LZ4F_isError(LZ4F_getFrameInfo(dctx.get(), &info, data, &inPos))) return nullptr;
+  if (info.contentSize > static_cast<unsigned long long>(maxSize)) return nullptr;
+
+  auto out = acquireSized(initialDecodedSize(static_cast<v_int64>(info.contentSize), size, maxSize));
+  size_t produced = 0;
+  while (true) {
+    size_t dstSize = out->size() - produced;
+    size_t srcSize = static_cast<size_t>(size) - inPos;
+    size_t rc = LZ4F_decompress(dctx.get(), out->data() + produced, &dstSize, data + inPos, &srcSize, nullptr);
+    if (LZ4F_isError(rc)) return nullptr;
+    produced += dstSize;
+    inPos += srcSize;
+    if (rc == 0 && inPos == static_cast<size_t>(size)) break;
+    // 无进展：输出满则扩容（结束标记/校验和不需要输出空间，所以已知长度时通常不会走到这里），否则数据被截断
+    if (dstSize == 0 && srcSize == 0) {
+      if (produced < out->size() || !grow(*out, maxSize)) return nullptr;
+    }
+  }
+  out->resize(produced);
+  return out;
+}
+
+#endif
+
+}
+
+bool ContentEncoding::isAvailable(Codec codec) {
+  switch (codec) {
+    case Codec::IDENTITY: return true;
+#ifdef OATPP_FLATBUFFERS_WITH_ZLIB
+    case Codec::GZIP: return true;
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+    case Codec::ZSTD: return true;
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_LZ4
+    case Codec::LZ4: return true;
+#endif
+    default: return false;
+  }
+}
+
+const char* ContentEncoding::getName(Codec codec) {
+  switch (codec) {
+    case Codec::GZIP: return "gzip";
+    case Codec::ZSTD: return "zstd";
+    case Codec::LZ4: return "lz4";
+    default: return "identity";
+  }
+}
+
+bool ContentEncoding::parse(const oatpp::String& name, Codec& codec) {
+  if (!name) {
+    codec = Codec::IDENTITY;
+    return true;
+  }
+  return parseToken(trimLower(name->data(), name->data() + name->size()), codec);
+}
+
+ContentEncoding::Codec ContentEncoding::negotiate(const oatpp::String& acceptEncoding, const Config& config) {
+  if (!acceptEncoding) {
+    return Codec::IDENTITY;
+  }
+  // 每个 codec 的 q 值；-1 表示未提及（此时取 `*` 的 q 值）
+  double q[4] = {-1, -1, -1, -1};
+  double wildcard = -1;
+  const char* p = acceptEncoding->data();
+  const char* end = p + acceptEncoding->size();
+  while (p < end) {
+    const char* itemEnd = std::find(p, end, ',');
+    const char* tokenEnd = std::find(p, itemEnd, ';');
+    std::string token = trimLower(p, tokenEnd);
+    double value = 1.0;
+    for (const char* param = tokenEnd; param < itemEnd; ) {
+      const char* paramEnd = std::find(param + 1, itemEnd, ';');
+      std::string kv = trimLower(param + 1, paramEnd);
+      if (kv.size() > 2 && kv[0] == 'q' && kv[1] == '=') {
+        value = std::strtod(kv.c_str() + 2, nullptr);
+      }
+      param = paramEnd;
+    }
+    Codec codec;
+    if (token == "*") {
+      wildcard = value;
+    } else if (!token.empty() && parseToken(token, codec)) {
+      q[static_cast<v_int32>(codec)] = value;
+    }
+    p = itemEnd < end ? itemEnd + 1 : end;
+  }
+
+  Codec best = Codec::IDENTITY;
+  double bestQ = 0;
+  for (auto codec : config.preference) {
+    if (codec == Codec::IDENTITY || !isAvailable(codec)) continue;
+    double value = q[static_cast<v_int32>(codec)] >= 0 ? q[static_cast<v_int32>(codec)] : wildcard;
+    if (value > bestQ) {
+      best = codec;
+      bestQ = value;
+    }
+  }
+  return best;
+}
+
+std::shared_ptr<std::vector<uint8_t>> ContentEncoding::encode(Codec codec, const uint8_t* data, v_buff_size size, [[maybe_unused]] v_int32 level) {
+  switch (codec) {
+    case Codec::IDENTITY: {
+      auto out = BufferPool::instance().acquire(size);
+      out->insert(out->end(), data, data + size);
+      return out;
+    }
+#ifdef OATPP_FLATBUFFERS_WITH_ZLIB
+    case Codec::GZIP: return gzipEncode(data, size, level);
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+    case Codec::ZSTD: return zstdEncode(data, size, level);
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_LZ4
+    case Codec::LZ4: return lz4Encode(data, size, level);
+#endif
+    default: return nullptr;
+  }
+}
+
+std::shared_ptr<std::vector<uint8_t>> ContentEncoding::decode(Codec codec, const uint8_t* data, v_buff_size size, v_buff_size maxDecodedSize) {
+  switch (codec) {
+    case Codec::IDENTITY: {
+      if (size > maxDecodedSize) return nullptr;
+      auto out = BufferPool::instance().acquire(size);
+      out->insert(out->end(), data, data + size);
+      return out;
+    }
+#ifdef OATPP_FLATBUFFERS_WITH_ZLIB
+    case Codec::GZIP: return gzipDecode(data, size, maxDecodedSize);
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+    case Codec::ZSTD: return zstdDecode(data, size, maxDecodedSize);
+#endif
+#ifdef OATPP_FLATBUFFERS_WITH_LZ4
+    case Codec::LZ4: return lz4Decode(data, size, maxDecodedSize);
+#endif
+    default: return nullptr;
+  }
+}
+
+}}
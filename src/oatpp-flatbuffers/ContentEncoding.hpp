@@ -0,0 +1,123 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_CONTENT_ENCODING_HPP
+#define OATPP_FLATBUFFERS_CONTENT_ENCODING_HPP
+
+#include "oatpp/Types.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * `application/x-flatbuffers` body 的 Content-Encoding 编解码（gzip / zstd / lz4）。
+ *
+ * - 各 codec 是否可用取决于构建时找到的库（`OATPP_FLATBUFFERS_WITH_ZLIB` / `_ZSTD` / `_LZ4`），
+ *   运行时用 `isAvailable()` 查询；identity 总是可用。
+ * - 编码/解码结果都放在 BufferPool 的池化缓冲中（起始地址至少 16 字节对齐），解码结果可直接交给
+ *   `ObjectMapper::readFromBuffer()` 作为 `Object<T>` 的自有存储，中间不经过 String。
+ * - lz4 使用 LZ4 Frame 格式（带内容长度），HTTP 令牌为 `lz4`（兼容 `x-lz4`）。
+ * - zstd 帧头带 dictID 时，解码自动使用 ZstdDictionaryRegistry 中登记的字典。
+ */
+class ContentEncoding {
+public:
+
+  enum class Codec : v_int32 {
+    IDENTITY = 0,
+    GZIP = 1,
+    ZSTD = 2,
+    LZ4 = 3
+  };
+
+  /**
+   * 协商与编码参数。
+   */
+  struct Config {
+    /**
+     * 小于该长度（字节）的 body 不压缩：压缩头与 CPU 开销得不偿失。
+     */
+    v_buff_size minSize = 1024;
+    /**
+     * 压缩级别；0 表示各 codec 的默认级别。
+     */
+    v_int32 level = 0;
+    /**
+     * 客户端给出相同 q 值时服务端的偏好顺序；不在列表中的 codec 不会被选中。
+     */
+    std::vector<Codec> preference = {Codec::ZSTD, Codec::LZ4, Codec::GZIP};
+    /**
+     * 解码结果上限，防止压缩炸弹。
+     */
+    v_buff_size maxDecodedSize = 64 * 1024 * 1024;
+    /**
+     * 选中 zstd 且 &id:oatpp::flatbuffers::ZstdDictionaryRegistry; 中有该 buffer file_identifier 的字典时，
+     * 用字典压缩；此时阈值改用 `dictionaryMinSize`（字典对小消息才有意义）。
+     */
+    bool useDictionaries = true;
+    v_buff_size dictionaryMinSize = 64;
+  };
+
+public:
+
+  /**
+   * 当前构建是否支持该 codec。
+   */
+  static bool isAvailable(Codec codec);
+
+  /**
+   * HTTP 令牌（"identity" / "gzip" / "zstd" / "lz4"）。
+   */
+  static const char* getName(Codec codec);
+
+  /**
+   * 解析 Content-Encoding 令牌（忽略大小写与首尾空白）；未知令牌返回 false。
+   * 空值或 nullptr 视为 identity。
+   */
+  static bool parse(const oatpp::String& name, Codec& codec);
+
+  /**
+   * 按 Accept-Encoding（含 q 值与 `*`）选择响应编码；没有可用且被接受的 codec 时返回 IDENTITY。
+   */
+  static Codec negotiate(const oatpp::String& acceptEncoding, const Config& config);
+
+  /**
+   * 压缩 [data, data + size)。
+   * @return - 池化缓冲；codec 不可用或失败时返回 nullptr。
+   */
+  static std::shared_ptr<std::vector<uint8_t>> encode(Codec codec, const uint8_t* data, v_buff_size size, v_int32 level = 0);
+
+  /**
+   * 解压 [data, data + size)。
+   * @param maxDecodedSize - 解码结果上限，超出即失败。
+   * @return - 池化缓冲；codec 不可用、数据损坏或超限时返回 nullptr。
+   */
+  static std::shared_ptr<std::vector<uint8_t>> decode(Codec codec, const uint8_t* data, v_buff_size size, v_buff_size maxDecodedSize);
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_CONTENT_ENCODING_HPP */
@@ -0,0 +1,165 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "FlatBuffersBody.hpp"
+#include "BufferPool.hpp"
+#include "ZstdDictionary.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace oatpp { namespace flatbuffers {
+
+FlatBuffersBody::FlatBuffersBody(const oatpp::Void& object, bool sizePrefixed, const oatpp::String& contentType)
+  : m_object(object)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_sizePrefixed(sizePrefixed)
+  , m_position(0)
+  , m_contentType(contentType)
+  , m_codec(ContentEncoding::Codec::IDENTITY)
+  , m_negotiated(false)
+{
+  const auto* vt = m_object.getValueType();
+  if (!m_object || !vt || !vt->extends(AbstractFlatBuffersObject::Class::getType())) {
+    throw std::runtime_error("[oatpp::flatbuffers::FlatBuffersBody::FlatBuffersBody()]: Error. Object is not a FlatBuffers object.");
+  }
+  auto raw = static_cast<const AbstractFlatBuffersObject*>(m_object.get());
+  m_data = raw->getBufferData();
+  m_size = raw->getBufferSize();
+  if (!m_data || m_size <= 0) {
+    throw std::runtime_error("[oatpp::flatbuffers::FlatBuffersBody::FlatBuffersBody()]: Error. Empty flatbuffers buffer.");
+  }
+  ::flatbuffers::WriteScalar<::flatbuffers::uoffset_t>(m_prefix, static_cast<::flatbuffers::uoffset_t>(m_size));
+}
+
+std::shared_ptr<FlatBuffersBody> FlatBuffersBody::createShared(const oatpp::Void& object,
+                                                               bool sizePrefixed,
+                                                               const oatpp::String& contentType) {
+  return std::make_shared<FlatBuffersBody>(object, sizePrefixed, contentType);
+}
+
+std::shared_ptr<FlatBuffersBody> FlatBuffersBody::createEncoded(const oatpp::Void& object,
+                                                                const oatpp::String& acceptEncoding,
+                                                                const ContentEncoding::Config& config,
+                                                                bool sizePrefixed,
+                                                                const oatpp::String& contentType) {
+  auto body = std::make_shared<FlatBuffersBody>(object, sizePrefixed, contentType);
+  body->m_negotiated = true;
+  auto codec = ContentEncoding::negotiate(acceptEncoding, config);
+  v_buff_size total = static_cast<v_buff_size>(body->getKnownSize());
+  // A dictionary trained for this file_identifier makes even small messages worth compressing
+  std::shared_ptr<ZstdDictionary> dictionary;
+  v_buff_size minSize = config.minSize;
+  if (codec == ContentEncoding::Codec::ZSTD && config.useDictionaries) {
+    dictionary = ZstdDictionaryRegistry::instance().findForBuffer(body->m_data, body->m_size);
+    if (dictionary) {
+      minSize = config.dictionaryMinSize;
+    }
+  }
+  if (codec == ContentEncoding::Codec::IDENTITY || total < minSize) {
+    return body;
+  }
+
+  std::shared_ptr<std::vector<uint8_t>> encoded;
+  if (sizePrefixed) {
+    // The prefix is part of the encoded payload: the decoded body is still a size-prefixed frame
+    auto framed = BufferPool::instance().acquire(total);
+    framed->insert(framed->end(), body->m_prefix, body->m_prefix + 4);
+    framed->insert(framed->end(), body->m_data, body->m_data + body->m_size);
+    encoded = dictionary ? dictionary->compress(framed->data(), total)
+                         : ContentEncoding::encode(codec, framed->data(), total, config.level);
+  } else {
+    encoded = dictionary ? dictionary->compress(body->m_data, body->m_size)
+                         : ContentEncoding::encode(codec, body->m_data, body->m_size, config.level);
+  }
+  if (!encoded || static_cast<v_buff_size>(encoded->size()) >= total) {
+    return body;
+  }
+
+  body->m_encoded = encoded;
+  body->m_codec = codec;
+  body->m_data = encoded->data();
+  body->m_size = static_cast<v_buff_size>(encoded->size());
+  body->m_sizePrefixed = false;
+  // The source buffer is no longer needed (e.g. a pooled builder goes back to its pool now)
+  body->m_object = nullptr;
+  return body;
+}
+
+ContentEncoding::Codec FlatBuffersBody::getContentEncoding() const {
+  return m_codec;
+}
+
+v_io_size FlatBuffersBody::read(void *buffer, v_buff_size count, async::Action& action) {
+  (void) action;
+  auto* out = static_cast<uint8_t*>(buffer);
+  v_buff_size written = 0;
+  const v_buff_size prefixSize = m_sizePrefixed ? 4 : 0;
+
+  if (m_position < prefixSize && written < count) {
+    v_buff_size n = std::min<v_buff_size>(prefixSize - m_position, count - written);
+    std::memcpy(out + written, m_prefix + m_position, static_cast<size_t>(n));
+    m_position += n;
+    written += n;
+  }
+
+  v_buff_size dataPos = m_position - prefixSize;
+  if (dataPos < m_size && written < count) {
+    v_buff_size n = std::min<v_buff_size>(m_size - dataPos, count - written);
+    std::memcpy(out + written, m_data + dataPos, static_cast<size_t>(n));
+    m_position += n;
+    written += n;
+  }
+
+  return written;
+}
+
+void FlatBuffersBody::declareHeaders(Headers& headers) {
+  if (m_contentType) {
+    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+  }
+  if (m_codec != ContentEncoding::Codec::IDENTITY) {
+    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_ENCODING, ContentEncoding::getName(m_codec));
+  }
+  if (m_negotiated) {
+    headers.putIfNotExists("Vary", "Accept-Encoding");
+  }
+}
+
+p_char8 FlatBuffersBody::getKnownData() {
+  if (m_sizePrefixed) {
+    return nullptr;
+  }
+  return const_cast<p_char8>(m_data);
+}
+
+v_int64 FlatBuffersBody::getKnownSize() {
+  return m_sizePrefixed ? m_size + 4 : m_size;
+}
+
+}}
@@ -0,0 +1,134 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_FLATBUFFERS_BODY_HPP
+#define OATPP_FLATBUFFERS_FLATBUFFERS_BODY_HPP
+
+#include "ContentEncoding.hpp"
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * Outgoing body that writes straight from the buffer of a FlatBuffers object.
+ * The body holds the object (and so its buffer or borrow anchor) until the response is sent.
+ * `getKnownData()` exposes the buffer itself, so the response is written to the connection
+ * without serializing into an intermediate buffer first (unlike `createDtoResponse`).
+ * Extends &id:oatpp::base::Countable;, &id:oatpp::web::protocol::http::outgoing::Body;.
+ */
+class FlatBuffersBody : public oatpp::base::Countable, public oatpp::web::protocol::http::outgoing::Body {
+private:
+  oatpp::Void m_object;
+  const uint8_t* m_data;
+  v_buff_size m_size;
+  bool m_sizePrefixed;
+  uint8_t m_prefix[4];
+  v_buff_size m_position;
+  oatpp::String m_contentType;
+  std::shared_ptr<std::vector<uint8_t>> m_encoded;
+  ContentEncoding::Codec m_codec;
+  bool m_negotiated;
+public:
+
+  /**
+   * Constructor.
+   * @param object - object whose type extends &id:oatpp::flatbuffers::AbstractFlatBuffersObject;.
+   * @param sizePrefixed - prepend 4-byte size prefix (body is then streamed via `read()`).
+   * @param contentType - Content-Type header value.
+   */
+  FlatBuffersBody(const oatpp::Void& object,
+                  bool sizePrefixed = false,
+                  const oatpp::String& contentType = "application/x-flatbuffers");
+
+  /**
+   * Create shared FlatBuffersBody.
+   * @param object - object whose type extends &id:oatpp::flatbuffers::AbstractFlatBuffersObject;.
+   * @param sizePrefixed - prepend 4-byte size prefix.
+   * @param contentType - Content-Type header value.
+   * @return - `std::shared_ptr` to FlatBuffersBody.
+   */
+  static std::shared_ptr<FlatBuffersBody> createShared(const oatpp::Void& object,
+                                                       bool sizePrefixed = false,
+                                                       const oatpp::String& contentType = "application/x-flatbuffers");
+
+  /**
+   * Create FlatBuffersBody compressed with the encoding negotiated from the request `Accept-Encoding`.
+   * The body is compressed once into pooled storage and declares `Content-Encoding` and `Vary`.
+   * Bodies smaller than &l:ContentEncoding::Config::minSize;, or that would not shrink, are sent as is.
+   * With zstd, a dictionary registered for the buffer's file_identifier in
+   * &id:oatpp::flatbuffers::ZstdDictionaryRegistry; is used, with `dictionaryMinSize` as the threshold.
+   * @param object - object whose type extends &id:oatpp::flatbuffers::AbstractFlatBuffersObject;.
+   * @param acceptEncoding - `Accept-Encoding` header value of the request. May be `nullptr`.
+   * @param config - &id:oatpp::flatbuffers::ContentEncoding::Config;.
+   * @param sizePrefixed - prepend 4-byte size prefix (the prefix is compressed together with the buffer).
+   * @param contentType - Content-Type header value.
+   * @return - `std::shared_ptr` to FlatBuffersBody.
+   */
+  static std::shared_ptr<FlatBuffersBody> createEncoded(const oatpp::Void& object,
+                                                        const oatpp::String& acceptEncoding,
+                                                        const ContentEncoding::Config& config = ContentEncoding::Config(),
+                                                        bool sizePrefixed = false,
+                                                        const oatpp::String& contentType = "application/x-flatbuffers");
+
+  /**
+   * Content encoding applied to the body.
+   * @return - &id:oatpp::flatbuffers::ContentEncoding::Codec;. `IDENTITY` if the body is sent as is.
+   */
+  ContentEncoding::Codec getContentEncoding() const;
+
+  /**
+   * Read operation callback.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Declare `Content-Type` header, and `Content-Encoding` / `Vary` for negotiated bodies.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Pointer to the object buffer. `nullptr` in size-prefixed mode.
+   * @return
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Return known size of the body.
+   * @return - `v_int64`.
+   */
+  v_int64 getKnownSize() override;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_FLATBUFFERS_BODY_HPP */
@@ -0,0 +1,141 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "FlatBuffersStreamBody.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+const AbstractFlatBuffersObject* asFlatBuffersObject(const oatpp::Void& object) {
+  const auto* vt = object.getValueType();
+  if (!object || !vt || !vt->extends(AbstractFlatBuffersObject::Class::getType())) {
+    throw std::runtime_error("[oatpp::flatbuffers::FlatBuffersStreamBody]: Error. Object is not a FlatBuffers object.");
+  }
+  return static_cast<const AbstractFlatBuffersObject*>(object.get());
+}
+
+}
+
+FlatBuffersStreamBody::FlatBuffersStreamBody(const Producer& producer, v_int64 knownSize, const oatpp::String& contentType)
+  : m_producer(producer)
+  , m_knownSize(knownSize)
+  , m_contentType(contentType)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_position(0)
+  , m_finished(false)
+{}
+
+std::shared_ptr<FlatBuffersStreamBody> FlatBuffersStreamBody::createShared(const Producer& producer,
+                                                                           const oatpp::String& contentType) {
+  return std::make_shared<FlatBuffersStreamBody>(producer, -1, contentType);
+}
+
+std::shared_ptr<FlatBuffersStreamBody> FlatBuffersStreamBody::createShared(const std::vector<oatpp::Void>& objects,
+                                                                           const oatpp::String& contentType) {
+  v_int64 size = 0;
+  for (const auto& object : objects) {
+    size += 4 + asFlatBuffersObject(object)->getBufferSize();
+  }
+  auto list = std::make_shared<std::vector<oatpp::Void>>(objects);
+  auto index = std::make_shared<size_t>(0);
+  auto producer = [list, index]() -> oatpp::Void {
+    if (*index >= list->size()) return nullptr;
+    return (*list)[(*index)++];
+  };
+  return std::make_shared<FlatBuffersStreamBody>(producer, size, contentType);
+}
+
+bool FlatBuffersStreamBody::nextFrame() {
+  m_current = m_producer();
+  if (!m_current) {
+    m_finished = true;
+    return false;
+  }
+  auto raw = asFlatBuffersObject(m_current);
+  m_data = raw->getBufferData();
+  m_size = raw->getBufferSize();
+  m_position = 0;
+  ::flatbuffers::WriteScalar<::flatbuffers::uoffset_t>(m_prefix, static_cast<::flatbuffers::uoffset_t>(m_size));
+  return true;
+}
+
+v_io_size FlatBuffersStreamBody::read(void *buffer, v_buff_size count, async::Action& action) {
+  (void) action;
+  auto* out = static_cast<uint8_t*>(buffer);
+  v_buff_size written = 0;
+
+  while (written < count && !m_finished) {
+    if (!m_current) {
+      try {
+        if (!nextFrame()) break;
+      } catch (const std::exception&) {
+        // 响应头已发出，无法再改状态码：中断连接，客户端会看到截断的帧
+        m_finished = true;
+        return oatpp::IOError::BROKEN_PIPE;
+      }
+    }
+    if (m_position < 4) {
+      v_buff_size n = std::min<v_buff_size>(4 - m_position, count - written);
+      std::memcpy(out + written, m_prefix + m_position, static_cast<size_t>(n));
+      m_position += n;
+      written += n;
+    }
+    v_buff_size dataPos = m_position - 4;
+    if (dataPos >= 0 && dataPos < m_size && written < count) {
+      v_buff_size n = std::min<v_buff_size>(m_size - dataPos, count - written);
+      std::memcpy(out + written, m_data + dataPos, static_cast<size_t>(n));
+      m_position += n;
+      written += n;
+    }
+    if (m_position == m_size + 4) {
+      m_current = nullptr;
+    }
+  }
+
+  return written;
+}
+
+void FlatBuffersStreamBody::declareHeaders(Headers& headers) {
+  if (m_contentType) {
+    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+  }
+}
+
+p_char8 FlatBuffersStreamBody::getKnownData() {
+  return nullptr;
+}
+
+v_int64 FlatBuffersStreamBody::getKnownSize() {
+  return m_knownSize;
+}
+
+}}
@@ -0,0 +1,126 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_FLATBUFFERS_STREAM_BODY_HPP
+#define OATPP_FLATBUFFERS_FLATBUFFERS_STREAM_BODY_HPP
+
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/Types.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * Outgoing body that writes a sequence of FlatBuffers objects as size-prefixed frames.
+ * Frames are pulled from a producer one at a time, so the whole reply is never buffered:
+ * at most one object is held at once. With an unknown size the response is sent
+ * with `Transfer-Encoding: chunked`.
+ * Extends &id:oatpp::base::Countable;, &id:oatpp::web::protocol::http::outgoing::Body;.
+ */
+class FlatBuffersStreamBody : public oatpp::base::Countable, public oatpp::web::protocol::http::outgoing::Body {
+public:
+  /**
+   * Returns the next object (whose type extends &id:oatpp::flatbuffers::AbstractFlatBuffersObject;),
+   * or `nullptr` to end the stream.
+   */
+  typedef std::function<oatpp::Void()> Producer;
+private:
+  Producer m_producer;
+  v_int64 m_knownSize;
+  oatpp::String m_contentType;
+  oatpp::Void m_current;
+  const uint8_t* m_data;
+  v_buff_size m_size;
+  uint8_t m_prefix[4];
+  v_buff_size m_position;
+  bool m_finished;
+private:
+  bool nextFrame();
+public:
+
+  /**
+   * Constructor.
+   * @param producer - frame producer.
+   * @param knownSize - total body size in bytes including prefixes, or -1 if unknown (chunked).
+   * @param contentType - Content-Type header value.
+   */
+  FlatBuffersStreamBody(const Producer& producer,
+                        v_int64 knownSize = -1,
+                        const oatpp::String& contentType = "application/x-flatbuffers");
+
+  /**
+   * Create shared FlatBuffersStreamBody of unknown size.
+   * @param producer - frame producer.
+   * @param contentType - Content-Type header value.
+   * @return - `std::shared_ptr` to FlatBuffersStreamBody.
+   */
+  static std::shared_ptr<FlatBuffersStreamBody> createShared(const Producer& producer,
+                                                             const oatpp::String& contentType = "application/x-flatbuffers");
+
+  /**
+   * Create shared FlatBuffersStreamBody over a list of objects. The size is known up front,
+   * so the body is sent with `Content-Length`; objects are written in place, not concatenated.
+   * @param objects - objects whose type extends &id:oatpp::flatbuffers::AbstractFlatBuffersObject;.
+   * @param contentType - Content-Type header value.
+   * @return - `std::shared_ptr` to FlatBuffersStreamBody.
+   */
+  static std::shared_ptr<FlatBuffersStreamBody> createShared(const std::vector<oatpp::Void>& objects,
+                                                             const oatpp::String& contentType = "application/x-flatbuffers");
+
+  /**
+   * Read operation callback.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Declare `Content-Type` header.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Always `nullptr`: frames are produced on demand.
+   * @return
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Return known size of the body, or -1.
+   * @return - `v_int64`.
+   */
+  v_int64 getKnownSize() override;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_FLATBUFFERS_STREAM_BODY_HPP */
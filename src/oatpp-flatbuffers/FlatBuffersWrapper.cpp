@@ -24,10 +24,70 @@
 
 #include "FlatBuffersWrapper.hpp"
 
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include <cstdlib>
+
 namespace oatpp { namespace flatbuffers {
 
-// Template specialization implementations would go here if needed
-// Currently, the template is fully defined in the header
+std::atomic<v_int64> AbstractFlatBuffersObject::s_pinnedBytes {0};
+
+FlatBuffersTypeRegistry::FlatBuffersTypeRegistry() {
+  m_snapshots.emplace_back(new Snapshot());
+  m_snapshot.store(m_snapshots.back().get(), std::memory_order_release);
+}
+
+FlatBuffersTypeRegistry& FlatBuffersTypeRegistry::instance() {
+  static FlatBuffersTypeRegistry inst;
+  return inst;
+}
+
+template<typename F>
+void FlatBuffersTypeRegistry::publish(F&& modify) {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  std::unique_ptr<Snapshot> next(new Snapshot(*m_snapshot.load(std::memory_order_relaxed)));
+  modify(*next);
+  m_snapshot.store(next.get(), std::memory_order_release);
+  m_snapshots.emplace_back(std::move(next));
+}
+
+void FlatBuffersTypeRegistry::registerFactory(const oatpp::data::type::Type* type, Factory factory, Verify verify, const std::string& name) {
+  publish([&](Snapshot& snapshot) {
+    auto& entry = snapshot.entries[type];
+    entry.type = type;
+    entry.factory = factory;
+    entry.verify = verify;
+    entry.name = name;
+  });
+}
+
+std::string FlatBuffersTypeRegistry::demangle(const char* name) {
+#if defined(__GNUG__)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled) {
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+  }
+#endif
+  std::string result(name);
+  for (const char* prefix : {"struct ", "class "}) {
+    if (result.compare(0, std::strlen(prefix), prefix) == 0) {
+      result.erase(0, std::strlen(prefix));
+      break;
+    }
+  }
+  return result;
+}
+
+void FlatBuffersTypeRegistry::registerFileIdentifier(const oatpp::data::type::Type* type, const char* identifier) {
+  publish([&](Snapshot& snapshot) {
+    snapshot.identifiers[identifierKey(identifier)] = type;
+  });
+}
 
 }}
 
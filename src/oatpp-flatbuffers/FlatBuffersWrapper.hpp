@@ -25,17 +25,30 @@
 #ifndef OATPP_FLATBUFFERS_FLATBUFFERS_WRAPPER_HPP
 #define OATPP_FLATBUFFERS_FLATBUFFERS_WRAPPER_HPP
 
+#include "Arena.hpp"
+#include "Metrics.hpp"
+
 #include "oatpp/Types.hpp"
 #include "oatpp/data/type/Object.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 #include <functional>
 
+#include "flatbuffers/base.h"
 #include "flatbuffers/buffer.h"
+#include "flatbuffers/verifier.h"
+#include "flatbuffers/flatbuffers.h"
 
 
 namespace oatpp { namespace flatbuffers {
@@ -47,15 +60,86 @@ namespace type = oatpp::data::type;
  */
 using CaretMemoryHandle = decltype(std::declval<oatpp::utils::parser::Caret>().getDataMemoryHandle());
 
+/**
+ * 类型化校验参数，对应 ::flatbuffers::Verifier 的 max_depth / max_tables，
+ * 另加整体缓冲大小上限（超过即拒绝，不进入 Verifier）。
+ */
+struct FlatBuffersVerifyOptions {
+  v_uint32 maxDepth = 64;
+  v_uint32 maxTables = 1000000;
+  v_buff_size maxSize = static_cast<v_buff_size>(FLATBUFFERS_MAX_BUFFER_SIZE - 1);
+};
+
 /**
  * ObjectMapper::read 提供给类型工厂的缓冲来源：要么拥有 vector 拷贝，要么借用
- * Caret 子区间并持有其内存句柄。
+ * Caret 子区间并持有其内存句柄；`inlineCopy` 为 true 且无句柄时，工厂把
+ * [borrowData, borrowData + borrowSize) 拷入与包装对象同一次分配的尾随存储；
+ * 设置了 `arena` 且无句柄时，拷贝与包装对象都分配在该 Arena 中；
+ * `keepAlive` 非空时借用其持有的可写缓冲（如 AlignedBodyReader 填充的池化缓冲）。
  */
 struct FlatBuffersBufferSource {
   std::shared_ptr<const std::vector<uint8_t>> owned;
   CaretMemoryHandle anchor;
+  std::shared_ptr<std::vector<uint8_t>> keepAlive;
   const uint8_t* borrowData = nullptr;
   v_buff_size borrowSize = 0;
+  // borrowData 之前紧邻的 size prefix 字节数（0 或 4）。builder 的对齐以含前缀的整段输出为基准：
+  // 拷贝连同前缀一起拷贝，延迟校验也从前缀起做；`owned` 非空时 owned 以前缀开头
+  v_buff_size prefixBytes = 0;
+  // `anchor` 所指整块内存的大小，计入 AbstractFlatBuffersObject::getPinnedBytes()
+  v_buff_size anchorSize = 0;
+  bool inlineCopy = false;
+  std::shared_ptr<Arena> arena;
+  // 非空时延迟校验：包装对象在首次 operator->() 时按这些参数校验
+  const FlatBuffersVerifyOptions* deferredVerify = nullptr;
+  // 延迟校验运行时是否计入 MapperMetrics（对应 ObjectMapper::Config::collectMetrics）
+  bool collectMetrics = true;
+};
+
+/**
+ * 供 std::allocate_shared 使用的分配器：在（含对象的）控制块之后追加 `trailingSize`
+ * 字节、按 ALIGNMENT 对齐的尾随存储，并在分配时把其地址写入 `*trailingOut`。
+ * 于是对象头、引用计数与 FlatBuffer 字节共用一次 malloc。
+ */
+template<typename U>
+class TrailingStorageAllocator {
+public:
+  using value_type = U;
+  static constexpr size_t ALIGNMENT = 16;
+public:
+  size_t trailingSize;
+  uint8_t** trailingOut;
+private:
+  static size_t headSize(size_t n) {
+    return (sizeof(U) * n + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+public:
+  TrailingStorageAllocator(size_t size, uint8_t** out)
+    : trailingSize(size)
+    , trailingOut(out)
+  {}
+  template<typename V>
+  TrailingStorageAllocator(const TrailingStorageAllocator<V>& other)
+    : trailingSize(other.trailingSize)
+    , trailingOut(other.trailingOut)
+  {}
+  U* allocate(size_t n) {
+    size_t head = headSize(n);
+    auto* p = static_cast<uint8_t*>(::operator new(head + trailingSize, std::align_val_t(ALIGNMENT)));
+    if (trailingOut) *trailingOut = p + head;
+    return reinterpret_cast<U*>(p);
+  }
+  void deallocate(U* p, size_t) {
+    ::operator delete(p, std::align_val_t(ALIGNMENT));
+  }
+  template<typename V>
+  bool operator==(const TrailingStorageAllocator<V>& other) const {
+    return trailingSize == other.trailingSize;
+  }
+  template<typename V>
+  bool operator!=(const TrailingStorageAllocator<V>& other) const {
+    return !(*this == other);
+  }
 };
 
 /**
@@ -68,34 +152,112 @@ public:
     static const oatpp::data::type::ClassId CLASS_ID;
     static oatpp::data::type::Type* getType();
   };
+private:
+  static std::atomic<v_int64> s_pinnedBytes;
+protected:
+  static void addPinnedBytes(v_int64 delta) {
+    s_pinnedBytes.fetch_add(delta, std::memory_order_relaxed);
+  }
+public:
+  /**
+   * 所有借用模式对象当前持有的锚点（请求 body 等）字节数之和。
+   * 按对象累计：多个对象共享同一锚点时重复计入。
+   */
+  static v_int64 getPinnedBytes() {
+    return s_pinnedBytes.load(std::memory_order_relaxed);
+  }
 public:
   virtual const uint8_t* getBufferData() const = 0;
   virtual v_buff_size getBufferSize() const = 0;
+  /**
+   * 具体包装类型（即 `FlatBuffersWrapper<T>::Class::getType()`），用于运行时识别 T。
+   */
+  virtual const oatpp::data::type::Type* getWrapperType() const = 0;
+  /**
+   * 完成延迟校验（如有）并返回 buffer 是否可安全解析，供按字段遍历 buffer 的代码使用。
+   */
+  virtual bool ensureVerified() const = 0;
 };
 
 /**
- * 工厂注册表：将具体 `FlatBuffersWrapper<T>` 的类型指针映射到构造器，
- * 以便 ObjectMapper::read() 能根据请求的 Type 创建对应 T 的包装对象。
+ * 工厂注册表：将具体 `FlatBuffersWrapper<T>` 的类型指针映射到构造器与类型化校验函数，
+ * 以便 ObjectMapper::read() 能根据请求的 Type 校验并创建对应 T 的包装对象。
+ * 另维护 4 字节 file_identifier -> Type 的索引，用于按 buffer 头部多态分发。
+ *
+ * 读多写少：注册（通常只在各类型首次 getType() 时发生）在写锁下复制当前快照、修改后
+ * 以原子指针发布；查找只做一次 acquire load 加哈希查找，不加锁、不复制 std::function。
+ * 旧快照保留到注册表析构，因此查找返回的 Entry 指针始终有效。
  */
 class FlatBuffersTypeRegistry {
 public:
-  using Factory = std::function<oatpp::Void(const FlatBuffersBufferSource&)>;
+  using Factory = oatpp::Void (*)(const FlatBuffersBufferSource&);
+  using Verify = bool (*)(const uint8_t*, v_buff_size, const FlatBuffersVerifyOptions&, bool);
+public:
+  struct Entry {
+    const oatpp::data::type::Type* type = nullptr;
+    Factory factory = nullptr;
+    Verify verify = nullptr;
+    // T 的限定名（如 "MyGame::Example::Monster"），用作指标的类型标签
+    std::string name;
+  };
 private:
-  std::mutex m_mutex;
-  std::unordered_map<const oatpp::data::type::Type*, Factory> m_factories;
+  struct Snapshot {
+    std::unordered_map<const oatpp::data::type::Type*, Entry> entries;
+    std::unordered_map<v_uint32, const oatpp::data::type::Type*> identifiers;
+  };
+private:
+  std::mutex m_writeMutex;
+  std::atomic<const Snapshot*> m_snapshot;
+  std::vector<std::unique_ptr<const Snapshot>> m_snapshots;
+private:
+  FlatBuffersTypeRegistry();
+  template<typename F>
+  void publish(F&& modify);
+  static v_uint32 identifierKey(const char* identifier) {
+    return ::flatbuffers::ReadScalar<v_uint32>(identifier);
+  }
 public:
-  static FlatBuffersTypeRegistry& instance() {
-    static FlatBuffersTypeRegistry inst;
-    return inst;
-  }
-  void registerFactory(const oatpp::data::type::Type* type, Factory factory) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_factories[type] = std::move(factory);
-  }
-  Factory findFactory(const oatpp::data::type::Type* type) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_factories.find(type);
-    if (it != m_factories.end()) return it->second;
+  FlatBuffersTypeRegistry(const FlatBuffersTypeRegistry&) = delete;
+  FlatBuffersTypeRegistry& operator=(const FlatBuffersTypeRegistry&) = delete;
+
+  static FlatBuffersTypeRegistry& instance();
+
+  void registerFactory(const oatpp::data::type::Type* type, Factory factory, Verify verify = nullptr, const std::string& name = "");
+
+  /**
+   * 把 `typeid(T).name()` 还原为可读的限定名（去掉编译器修饰与 MSVC 的 "struct " / "class " 前缀）。
+   */
+  static std::string demangle(const char* name);
+
+  /**
+   * 绑定 file_identifier（必须恰好 4 个字符，如 "MONS"）到已注册的类型。
+   */
+  void registerFileIdentifier(const oatpp::data::type::Type* type, const char* identifier);
+
+  /**
+   * 无锁查找；未注册返回 nullptr。
+   */
+  const Entry* findEntry(const oatpp::data::type::Type* type) const {
+    const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+    auto it = snapshot->entries.find(type);
+    if (it != snapshot->entries.end()) return &it->second;
+    return nullptr;
+  }
+  Factory findFactory(const oatpp::data::type::Type* type) const {
+    auto entry = findEntry(type);
+    return entry ? entry->factory : nullptr;
+  }
+  Verify findVerify(const oatpp::data::type::Type* type) const {
+    auto entry = findEntry(type);
+    return entry ? entry->verify : nullptr;
+  }
+  /**
+   * 按 buffer 中 4..8 字节处的 file_identifier 查找类型；未注册返回 nullptr。
+   */
+  const oatpp::data::type::Type* findTypeByFileIdentifier(const char* identifier) const {
+    const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+    auto it = snapshot->identifiers.find(identifierKey(identifier));
+    if (it != snapshot->identifiers.end()) return it->second;
     return nullptr;
   }
 };
@@ -111,47 +273,159 @@ public:
   public:
     static const oatpp::data::type::ClassId CLASS_ID;
     static oatpp::data::type::Type* getType();
+    /**
+     * 为 T 绑定 file_identifier（例如 `MyGame::Example::MonsterIdentifier()`），
+     * 之后按 AbstractFlatBuffersObject 读取时可根据 buffer 头部分发到 T。
+     */
+    static void setFileIdentifier(const char* identifier) {
+      FlatBuffersTypeRegistry::instance().registerFileIdentifier(getType(), identifier);
+    }
   };
+  /**
+   * 单次分配存储模式的构造标签，见 `fromBytes()`。
+   */
+  struct InlineStorage {};
 private:
-  std::shared_ptr<const std::vector<uint8_t>> m_constBuffer;
-  std::shared_ptr<std::vector<uint8_t>> m_mutableBuffer;
-  CaretMemoryHandle m_borrowHandle;
-  const uint8_t* m_borrowData = nullptr;
-  v_buff_size m_borrowSize = 0;
-  const T* m_constTable = nullptr;
-  T* m_mutableTable = nullptr;
+  // buffer 内存的所有者：vector、Caret 锚点、DetachedBuffer、池化 builder 或 Arena，释放时归还给其所有者；
+  // 尾随存储模式下为空（内存与包装对象属于同一次分配）
+  std::shared_ptr<void> m_keepAlive;
+  // 所有模式共用的数据视图
+  const uint8_t* m_viewData = nullptr;
+  v_buff_size m_viewSize = 0;
+  const T* m_table = nullptr;
+  // 延迟校验状态，见 deferVerification() / ensureVerified()
+  mutable std::atomic<v_int32> m_verifyState {VERIFY_STATE_VALID};
+  // 只读 buffer（const vector、Caret 锚点）上 getMutableTable() 返回 nullptr
+  bool m_mutable = true;
+  bool m_verifyMetrics = true;
+  bool m_verifyPrefixed = false;
+  FlatBuffersVerifyOptions m_verifyOptions;
+  // 借用模式下被钉住的锚点字节数
+  v_buff_size m_pinnedBytes = 0;
+public:
+  static constexpr v_int32 VERIFY_STATE_VALID = 0;
+  static constexpr v_int32 VERIFY_STATE_PENDING = 1;
+  static constexpr v_int32 VERIFY_STATE_INVALID = 2;
 public:
   FlatBuffersWrapper(const std::shared_ptr<const std::vector<uint8_t>>& buffer, const T* table)
-    : m_constBuffer(buffer)
-    , m_constTable(table)
+    : m_keepAlive(std::const_pointer_cast<std::vector<uint8_t>>(buffer))
+    , m_viewData(buffer ? buffer->data() : nullptr)
+    , m_viewSize(buffer ? static_cast<v_buff_size>(buffer->size()) : 0)
+    , m_table(table)
+    , m_mutable(false)
   {}
   FlatBuffersWrapper(const std::shared_ptr<std::vector<uint8_t>>& buffer, T* table)
-    : m_mutableBuffer(buffer)
-    , m_mutableTable(table)
+    : m_keepAlive(buffer)
+    , m_viewData(buffer ? buffer->data() : nullptr)
+    , m_viewSize(buffer ? static_cast<v_buff_size>(buffer->size()) : 0)
+    , m_table(table)
   {}
-  FlatBuffersWrapper(CaretMemoryHandle anchor, const uint8_t* data, v_buff_size size, const T* table)
-    : m_borrowHandle(std::move(anchor))
-    , m_borrowData(data)
-    , m_borrowSize(size)
-    , m_constTable(table)
+  FlatBuffersWrapper(CaretMemoryHandle anchor, const uint8_t* data, v_buff_size size, const T* table, v_buff_size anchorSize = 0)
+    : m_keepAlive(std::move(anchor))
+    , m_viewData(data)
+    , m_viewSize(size)
+    , m_table(table)
+    , m_mutable(false)
+    , m_pinnedBytes(anchorSize > size ? anchorSize : size)
+  {
+    addPinnedBytes(m_pinnedBytes);
+  }
+  /**
+   * 尾随存储模式：`*storage` 已由 TrailingStorageAllocator 指向本对象所在分配块的尾部。
+   * 拷入 [data - prefix, data + size)，视图从前缀之后开始。
+   */
+  FlatBuffersWrapper(InlineStorage, uint8_t** storage, const uint8_t* data, v_buff_size size, v_buff_size lead = 0, v_buff_size prefix = 0)
+    : m_viewData(*storage + lead + prefix)
+    , m_viewSize(size)
+  {
+    std::memcpy(*storage + lead, data - prefix, static_cast<size_t>(size + prefix));
+    m_table = ::flatbuffers::GetRoot<T>(m_viewData);
+  }
+  /**
+   * 外部存储模式：`storage` 拥有 [data, data + size)，包装对象存活期间保持其存活。
+   */
+  FlatBuffersWrapper(std::shared_ptr<void> storage, uint8_t* data, v_buff_size size)
+    : m_keepAlive(std::move(storage))
+    , m_viewData(data)
+    , m_viewSize(size)
+    , m_table(::flatbuffers::GetRoot<T>(data))
   {}
+  ~FlatBuffersWrapper() {
+    if (m_pinnedBytes > 0) addPinnedBytes(-m_pinnedBytes);
+  }
   const T* getTable() const {
-    return m_mutableTable ? m_mutableTable : m_constTable;
+    return m_table;
   }
   T* getMutableTable() const {
-    return m_mutableTable;
+    return m_mutable ? const_cast<T*>(m_table) : nullptr;
+  }
+  /**
+   * 标记为未校验：首次访问（`Object<T>::operator->()` / `getMutable()`）时才运行 `verify()`。
+   * 只被转发（ObjectMapper::write / FlatBuffersBody）的对象不会触发校验。
+   * @param collectMetrics - 校验运行时是否计时并记入 MapperMetrics。
+   * @param sizePrefixed - 视图之前紧邻 4 字节的 size prefix，校验从前缀起做（见 `verify()`）。
+   */
+  void deferVerification(const FlatBuffersVerifyOptions& options, bool collectMetrics = true, bool sizePrefixed = false) {
+    m_verifyOptions = options;
+    m_verifyMetrics = collectMetrics;
+    m_verifyPrefixed = sizePrefixed;
+    m_verifyState.store(VERIFY_STATE_PENDING, std::memory_order_release);
+  }
+  /**
+   * 是否借用了 Caret 锚点（对象存活期间钉住整块请求 body）。
+   */
+  bool isBorrowed() const {
+    return m_pinnedBytes > 0;
+  }
+  /**
+   * 借用模式下返回恰好大小的独立拷贝（单次分配，见 `fromBytes()`），释放对锚点的引用；
+   * 其他模式返回 nullptr，调用方继续使用原对象。未完成的延迟校验随拷贝一起保留。
+   */
+  std::shared_ptr<FlatBuffersWrapper<T>> compact() const {
+    if (!isBorrowed()) return nullptr;
+    // 尚未校验的 size-prefixed 视图连同前缀一起拷贝，之后仍能从前缀起校验
+    const bool pending = m_verifyState.load(std::memory_order_acquire) != VERIFY_STATE_VALID;
+    const v_buff_size prefix = pending && m_verifyPrefixed ? 4 : 0;
+    // 保持原区间相对 16 字节边界的偏移，拷贝的对齐与原 buffer 一致
+    auto lead = static_cast<v_buff_size>(reinterpret_cast<uintptr_t>(m_viewData - prefix) & (TrailingStorageAllocator<FlatBuffersWrapper<T>>::ALIGNMENT - 1));
+    auto copy = fromBytes(m_viewData, m_viewSize, lead, prefix);
+    if (copy && pending) {
+      copy->deferVerification(m_verifyOptions, m_verifyMetrics, prefix > 0);
+    }
+    return copy;
+  }
+  /**
+   * 校验一次并记住结果；之后只是一次原子读。
+   * 并发的首次访问可能各自校验一遍，结果相同，无需加锁。
+   */
+  bool ensureVerified() const override {
+    v_int32 state = m_verifyState.load(std::memory_order_acquire);
+    if (state != VERIFY_STATE_PENDING) return state == VERIFY_STATE_VALID;
+    const uint8_t* data = getBufferData();
+    v_buff_size size = getBufferSize();
+    if (m_verifyPrefixed) {
+      data -= 4;
+      size += 4;
+    }
+    bool ok;
+    if (m_verifyMetrics) {
+      auto start = std::chrono::steady_clock::now();
+      ok = verify(data, size, m_verifyOptions, m_verifyPrefixed);
+      MapperMetrics::instance().recordVerify(Class::getType(), MapperMetrics::nanosSince(start), ok);
+    } else {
+      ok = verify(data, size, m_verifyOptions, m_verifyPrefixed);
+    }
+    m_verifyState.store(ok ? VERIFY_STATE_VALID : VERIFY_STATE_INVALID, std::memory_order_release);
+    return ok;
+  }
+  const oatpp::data::type::Type* getWrapperType() const override {
+    return Class::getType();
   }
   const uint8_t* getBufferData() const override {
-    if (m_borrowHandle) return m_borrowData;
-    if (m_mutableBuffer) return m_mutableBuffer->data();
-    if (m_constBuffer) return m_constBuffer->data();
-    return nullptr;
+    return m_viewData;
   }
   v_buff_size getBufferSize() const override {
-    if (m_borrowHandle) return m_borrowSize;
-    if (m_mutableBuffer) return static_cast<v_buff_size>(m_mutableBuffer->size());
-    if (m_constBuffer) return static_cast<v_buff_size>(m_constBuffer->size());
-    return 0;
+    return m_viewSize;
   }
   static std::shared_ptr<FlatBuffersWrapper<T>> createShared(
       const std::shared_ptr<const std::vector<uint8_t>>& buffer,
@@ -163,19 +437,125 @@ public:
       T* table) {
     return std::make_shared<FlatBuffersWrapper<T>>(buffer, table);
   }
+  /**
+   * 类型化校验 [data, data + size) 处的一段完整 FlatBuffer，始终检查对齐。
+   * Verifier 按相对 `data` 的偏移检查对齐，builder 的对齐基准则是整段输出（含 size prefix）的起点，
+   * 所以 size-prefixed 的帧必须从前缀起以 `VerifySizePrefixedBuffer<T>` 校验：`sizePrefixed` 为 true 时
+   * `data` 指向前缀、`size` 含前缀；去掉前缀后的视图起点差 4 字节，无法正确检查 8 字节对齐的字段。
+   * `options.maxSize` 始终针对前缀之后的 buffer。
+   */
+  static bool verify(const uint8_t* data, v_buff_size size, const FlatBuffersVerifyOptions& options, bool sizePrefixed = false) {
+    const v_buff_size prefix = sizePrefixed ? 4 : 0;
+    if (!data || size < prefix + 4 || size - prefix > options.maxSize) return false;
+    ::flatbuffers::Verifier verifier(data, static_cast<size_t>(size), options.maxDepth, options.maxTables);
+    return sizePrefixed ? verifier.VerifySizePrefixedBuffer<T>(nullptr) : verifier.VerifyBuffer<T>(nullptr);
+  }
+  /**
+   * 拷贝 [data, data + size) 到与包装对象同一次分配的对齐尾随存储中：一次 malloc、一个引用计数。
+   * `lead` 为存储起点前预留的字节数，`prefix` 为一并拷贝的、`data` 之前紧邻的 size prefix 字节数。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromBytes(const uint8_t* data, v_buff_size size, v_buff_size lead = 0, v_buff_size prefix = 0) {
+    if (!data || size < 4) return nullptr;
+    uint8_t* storage = nullptr;
+    return std::allocate_shared<FlatBuffersWrapper<T>>(
+        TrailingStorageAllocator<FlatBuffersWrapper<T>>(static_cast<size_t>(lead + prefix + size), &storage),
+        InlineStorage(), &storage, data, size, lead, prefix);
+  }
+  /**
+   * 接管 DetachedBuffer 的所有权（零拷贝）；buffer 为空时返回 nullptr。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromDetachedBuffer(::flatbuffers::DetachedBuffer&& buffer) {
+    if (!buffer.data() || buffer.size() < 4) return nullptr;
+    auto detached = std::make_shared<::flatbuffers::DetachedBuffer>(std::move(buffer));
+    uint8_t* data = detached->data();
+    auto size = static_cast<v_buff_size>(detached->size());
+    return fromStorage(std::move(detached), data, size);
+  }
+  /**
+   * 从已 Finish() 的 builder 中 Release() 出内存并接管（零拷贝）。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromBuilder(::flatbuffers::FlatBufferBuilder&& builder) {
+    return fromDetachedBuffer(builder.Release());
+  }
+  /**
+   * 包装任意所有者持有的 buffer（零拷贝）。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromStorage(std::shared_ptr<void> storage, uint8_t* data, v_buff_size size) {
+    if (!storage || !data || size < 4) return nullptr;
+    return std::make_shared<FlatBuffersWrapper<T>>(std::move(storage), data, size);
+  }
+  /**
+   * 包装从 BuilderPool 取得且已 Finish() 的 builder 的输出（零拷贝）；
+   * 最后一个引用释放时 builder 被 Clear() 并回到池中。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromPooledBuilder(std::shared_ptr<::flatbuffers::FlatBufferBuilder> builder) {
+    if (!builder) return nullptr;
+    uint8_t* data = builder->GetBufferPointer();
+    v_buff_size size = static_cast<v_buff_size>(builder->GetSize());
+    return fromStorage(std::shared_ptr<void>(std::move(builder)), data, size);
+  }
+  /**
+   * 包装 Arena 中的 buffer（零拷贝）；包装对象本身也分配在 Arena 中，并持有 Arena 的引用。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromArenaStorage(const std::shared_ptr<Arena>& arena, uint8_t* data, v_buff_size size) {
+    if (!arena || !data || size < 4) return nullptr;
+    return std::allocate_shared<FlatBuffersWrapper<T>>(
+        ArenaStlAllocator<FlatBuffersWrapper<T>>(arena), std::shared_ptr<void>(arena), data, size);
+  }
+  /**
+   * 拷贝 [data, data + size) 到 Arena 中并包装；`prefix` 含义同 `fromBytes()`。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromArenaBytes(const std::shared_ptr<Arena>& arena, const uint8_t* data, v_buff_size size, v_buff_size prefix = 0) {
+    if (!arena || !data || size < 4) return nullptr;
+    auto* storage = static_cast<uint8_t*>(arena->allocate(prefix + size));
+    std::memcpy(storage, data - prefix, static_cast<size_t>(prefix + size));
+    return fromArenaStorage(arena, storage + prefix, size);
+  }
+  /**
+   * 从已 Finish() 的 builder 中 ReleaseRaw() 出内存并包装（零拷贝）。
+   * builder 必须以 `arena->getFlatBuffersAllocator()` 构造。
+   */
+  static std::shared_ptr<FlatBuffersWrapper<T>> fromArenaBuilder(const std::shared_ptr<Arena>& arena, ::flatbuffers::FlatBufferBuilder& builder) {
+    size_t reserved = 0;
+    size_t offset = 0;
+    uint8_t* raw = builder.ReleaseRaw(reserved, offset);
+    if (!raw) return nullptr;
+    return fromArenaStorage(arena, raw + offset, static_cast<v_buff_size>(reserved - offset));
+  }
   static std::shared_ptr<FlatBuffersWrapper<T>> fromSource(const FlatBuffersBufferSource& src) {
+    auto wrapper = wrapSource(src);
+    if (wrapper && src.deferredVerify) {
+      wrapper->deferVerification(*src.deferredVerify, src.collectMetrics, src.prefixBytes > 0);
+    }
+    return wrapper;
+  }
+  static std::shared_ptr<FlatBuffersWrapper<T>> wrapSource(const FlatBuffersBufferSource& src) {
     if (src.owned) {
       if (src.owned->empty()) return nullptr;
+      if (src.prefixBytes > 0) {
+        // owned 是 ObjectMapper 自己的拷贝，数据位于前缀之后
+        auto storage = std::const_pointer_cast<std::vector<uint8_t>>(src.owned);
+        return fromStorage(storage, storage->data() + src.prefixBytes, static_cast<v_buff_size>(storage->size()) - src.prefixBytes);
+      }
       const uint8_t* data = src.owned->data();
       const T* table = ::flatbuffers::GetRoot<T>(data);
       return createShared(src.owned, table);
     }
+    if (src.keepAlive) {
+      return fromStorage(src.keepAlive, const_cast<uint8_t*>(src.borrowData), src.borrowSize);
+    }
+    if (!src.anchor && src.arena) {
+      return fromArenaBytes(src.arena, src.borrowData, src.borrowSize, src.prefixBytes);
+    }
+    if (!src.anchor && src.inlineCopy) {
+      return fromBytes(src.borrowData, src.borrowSize, 0, src.prefixBytes);
+    }
     if (!src.anchor || !src.borrowData || src.borrowSize < 4) {
       return nullptr;
     }
     const T* table = ::flatbuffers::GetRoot<T>(src.borrowData);
     return std::make_shared<FlatBuffersWrapper<T>>(
-        CaretMemoryHandle(src.anchor), src.borrowData, src.borrowSize, table);
+        CaretMemoryHandle(src.anchor), src.borrowData, src.borrowSize, table, src.anchorSize);
   }
   static std::shared_ptr<FlatBuffersWrapper<T>> fromBuffer(
       const std::shared_ptr<const std::vector<uint8_t>>& buffer) {
@@ -201,11 +581,31 @@ class Object : public oatpp::data::type::ObjectWrapper<FlatBuffersWrapper<T>, ty
   using Wrapper = oatpp::data::type::ObjectWrapper<FlatBuffersWrapper<T>, typename FlatBuffersWrapper<T>::Class>;
 public:
   OATPP_DEFINE_OBJECT_WRAPPER_DEFAULTS(Object, FlatBuffersWrapper<T>, typename FlatBuffersWrapper<T>::Class)
+  /**
+   * 借用请求 body 的对象若要在请求结束后继续保存（如放入缓存），先取其紧凑拷贝，
+   * 避免整块 body 一直被钉住；非借用对象原样返回。
+   */
+  Object<T> compacted() const {
+    if (!this->m_ptr) return *this;
+    auto copy = this->m_ptr->compact();
+    return copy ? Object<T>(std::move(copy)) : *this;
+  }
+  /**
+   * 延迟校验模式下首次访问时校验，失败抛出 std::runtime_error。
+   */
   const T* operator->() const {
-    return this->m_ptr ? this->m_ptr->getTable() : nullptr;
+    if (!this->m_ptr) return nullptr;
+    if (!this->m_ptr->ensureVerified()) {
+      throw std::runtime_error("[oatpp::flatbuffers::Object::operator->()]: FlatBuffers verification failed");
+    }
+    return this->m_ptr->getTable();
   }
   T* getMutable() const {
-    return this->m_ptr ? this->m_ptr->getMutableTable() : nullptr;
+    if (!this->m_ptr) return nullptr;
+    if (!this->m_ptr->ensureVerified()) {
+      throw std::runtime_error("[oatpp::flatbuffers::Object::getMutable()]: FlatBuffers verification failed");
+    }
+    return this->m_ptr->getMutableTable();
   }
   static Object<T> fromBuffer(const std::shared_ptr<const std::vector<uint8_t>>& buffer) {
     return Object<T>(FlatBuffersWrapper<T>::fromBuffer(buffer));
@@ -213,6 +613,42 @@ public:
   static Object<T> fromMutableBuffer(const std::shared_ptr<std::vector<uint8_t>>& buffer) {
     return Object<T>(FlatBuffersWrapper<T>::fromMutableBuffer(buffer));
   }
+  static Object<T> fromBytes(const uint8_t* data, v_buff_size size) {
+    return Object<T>(FlatBuffersWrapper<T>::fromBytes(data, size));
+  }
+  static Object<T> fromDetachedBuffer(::flatbuffers::DetachedBuffer&& buffer) {
+    return Object<T>(FlatBuffersWrapper<T>::fromDetachedBuffer(std::move(buffer)));
+  }
+  static Object<T> fromBuilder(::flatbuffers::FlatBufferBuilder&& builder) {
+    return Object<T>(FlatBuffersWrapper<T>::fromBuilder(std::move(builder)));
+  }
+  static Object<T> fromPooledBuilder(std::shared_ptr<::flatbuffers::FlatBufferBuilder> builder) {
+    return Object<T>(FlatBuffersWrapper<T>::fromPooledBuilder(std::move(builder)));
+  }
+  static Object<T> fromArenaBytes(const std::shared_ptr<Arena>& arena, const uint8_t* data, v_buff_size size) {
+    return Object<T>(FlatBuffersWrapper<T>::fromArenaBytes(arena, data, size));
+  }
+  static Object<T> fromArenaBuilder(const std::shared_ptr<Arena>& arena, ::flatbuffers::FlatBufferBuilder& builder) {
+    return Object<T>(FlatBuffersWrapper<T>::fromArenaBuilder(arena, builder));
+  }
+};
+
+/**
+ * 任意已注册 T 的 FlatBuffers 对象。按 `AnyObject` 读取时，ObjectMapper 根据 buffer 的
+ * file_identifier 选择具体类型；再通过 `is<T>()` / `as<T>()` 取回 `Object<T>`。
+ */
+class AnyObject : public oatpp::data::type::ObjectWrapper<AbstractFlatBuffersObject, AbstractFlatBuffersObject::Class> {
+public:
+  OATPP_DEFINE_OBJECT_WRAPPER_DEFAULTS(AnyObject, AbstractFlatBuffersObject, AbstractFlatBuffersObject::Class)
+  template<typename T>
+  bool is() const {
+    return this->m_ptr && this->m_ptr->getWrapperType() == FlatBuffersWrapper<T>::Class::getType();
+  }
+  template<typename T>
+  Object<T> as() const {
+    if (!is<T>()) return nullptr;
+    return Object<T>(std::static_pointer_cast<FlatBuffersWrapper<T>>(this->m_ptr));
+  }
 };
 
 // ===== 类型与注册实现 =====
@@ -235,7 +671,7 @@ inline oatpp::data::type::Type* FlatBuffersWrapper<T>::Class::getType() {
     FlatBuffersTypeRegistry::instance().registerFactory(t, [](const FlatBuffersBufferSource& src){
       auto w = FlatBuffersWrapper<T>::fromSource(src);
       return oatpp::Void(w, FlatBuffersWrapper<T>::Class::getType());
-    });
+    }, &FlatBuffersWrapper<T>::verify, FlatBuffersTypeRegistry::demangle(typeid(T).name()));
     return t;
   }();
   return type;
@@ -0,0 +1,177 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_FRAME_READER_HPP
+#define OATPP_FLATBUFFERS_FRAME_READER_HPP
+
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/async/Coroutine.hpp"
+#include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+#include "oatpp/IODefinitions.hpp"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 异步流式解码器：从 InputStream 逐帧读取 size-prefixed FlatBuffers，
+ * 每凑齐一帧即通过 ObjectMapper 构造 `Object<T>` 并交给协程回调。
+ *
+ * - 每帧单独分配一个 oatpp::String（含 4 字节前缀），Caret 借用该 String，不再拷贝；
+ *   峰值内存由最大帧决定，而不是整个 body。
+ * - 流必须给出已解码的 body 字节（例如 Content-Length body 的 `getBodyStream()`），
+ *   `contentLength >= 0` 时最多读取该字节数，避免越界读到同连接上的下一个请求。
+ * - 回调返回的 CoroutineStarter 执行完毕后才继续读下一帧；可返回 nullptr 表示无异步操作。
+ *
+ * @tparam T - FlatBuffers 生成的 Table 类型
+ */
+template<typename T>
+class FrameReader : public oatpp::async::Coroutine<FrameReader<T>> {
+public:
+  using Callback = std::function<oatpp::async::CoroutineStarter(const Object<T>&)>;
+  using Action = oatpp::async::Action;
+private:
+  std::shared_ptr<oatpp::data::stream::InputStream> m_stream;
+  std::shared_ptr<ObjectMapper> m_mapper;
+  Callback m_callback;
+  v_int64 m_bytesLeft;
+  v_buff_size m_maxFrameSize;
+  uint8_t m_prefix[4];
+  oatpp::String m_frame;
+  v_buff_size m_filled = 0;
+private:
+
+  /*
+   * 读取到 buffer[m_filled..target)。返回值：
+   * > 0 - 已读满；0 - 流结束；Action 非空 - 需要等待/重试/出错。
+   */
+  v_io_size readInto(uint8_t* buffer, v_buff_size target, Action& action) {
+    v_buff_size want = target - m_filled;
+    if (m_bytesLeft >= 0 && want > m_bytesLeft) {
+      want = static_cast<v_buff_size>(m_bytesLeft);
+    }
+    if (want == 0) {
+      return m_filled == target ? 1 : 0;
+    }
+    auto res = m_stream->read(buffer + m_filled, want, action);
+    if (!action.isNone()) {
+      return -1;
+    }
+    if (res > 0) {
+      m_filled += res;
+      if (m_bytesLeft >= 0) m_bytesLeft -= res;
+      if (m_filled == target) return 1;
+      action = this->repeat();
+      return -1;
+    }
+    if (res == oatpp::IOError::RETRY_READ || res == oatpp::IOError::RETRY_WRITE) {
+      action = this->repeat();
+      return -1;
+    }
+    if (res == 0 || res == oatpp::IOError::ZERO_VALUE) {
+      return 0;
+    }
+    action = this->template error<oatpp::async::Error>("[oatpp::flatbuffers::FrameReader]: Stream read error");
+    return -1;
+  }
+
+public:
+
+  /**
+   * Constructor.
+   * @param stream - 已解码的 body 输入流。
+   * @param mapper - 用于构造 `Object<T>` 的 ObjectMapper（是否 sizePrefixed 均可）。
+   * @param callback - 每帧回调。
+   * @param contentLength - body 总长度；-1 表示读到流结束。
+   * @param maxFrameSize - 单帧上限（不含前缀），超过即报错。
+   */
+  FrameReader(const std::shared_ptr<oatpp::data::stream::InputStream>& stream,
+              const std::shared_ptr<ObjectMapper>& mapper,
+              const Callback& callback,
+              v_int64 contentLength = -1,
+              v_buff_size maxFrameSize = 16 * 1024 * 1024)
+    : m_stream(stream)
+    , m_mapper(mapper)
+    , m_callback(callback)
+    , m_bytesLeft(contentLength)
+    , m_maxFrameSize(maxFrameSize)
+  {}
+
+  Action act() override {
+    m_filled = 0;
+    return this->yieldTo(&FrameReader::readPrefix);
+  }
+
+  Action readPrefix() {
+    Action action;
+    auto res = readInto(m_prefix, 4, action);
+    if (res < 0) return action;
+    if (res == 0) {
+      if (m_filled == 0) return this->finish();
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::FrameReader::readPrefix()]: Truncated size prefix");
+    }
+    v_buff_size frameSize = static_cast<v_buff_size>(::flatbuffers::GetPrefixedSize(m_prefix));
+    if (frameSize < 4 || frameSize > m_maxFrameSize) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::FrameReader::readPrefix()]: Invalid frame size");
+    }
+    m_frame = oatpp::String(frameSize + 4);
+    std::memcpy(&m_frame->front(), m_prefix, 4);
+    return this->yieldTo(&FrameReader::readFrame);
+  }
+
+  Action readFrame() {
+    Action action;
+    auto res = readInto(reinterpret_cast<uint8_t*>(&m_frame->front()), static_cast<v_buff_size>(m_frame->size()), action);
+    if (res < 0) return action;
+    if (res == 0) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::FrameReader::readFrame()]: Truncated frame");
+    }
+    return this->yieldTo(&FrameReader::onFrame);
+  }
+
+  Action onFrame() {
+    oatpp::utils::parser::Caret caret(m_frame);
+    if (!m_mapper->getConfig().sizePrefixed) {
+      caret.setPosition(4);
+    }
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = m_mapper->read(caret, Object<T>::Class::getType(), errorStack);
+    m_frame = nullptr;
+    m_filled = 0;
+    if (!errorStack.empty() || !value) {
+      return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::FrameReader::onFrame()]: Failed to map frame");
+    }
+    return m_callback(value.template cast<Object<T>>()).next(this->yieldTo(&FrameReader::readPrefix));
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_FRAME_READER_HPP */
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_FRAME_SINK_HPP
+#define OATPP_FLATBUFFERS_FRAME_SINK_HPP
+
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+#include "oatpp/IODefinitions.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 推模式的 size-prefixed 帧解码器：作为 OutputStream 接收任意切分的字节，
+ * 每凑齐一帧即构造 `Object<T>` 并同步回调。
+ *
+ * 与 FrameReader 互补：FrameReader 从已解码的 InputStream 拉取（Content-Length body）；
+ * FrameSink 用于 `transferBodyToStreamAsync()`，由 oatpp 先解开 chunked 编码再写入，
+ * 因此适合大小未知的请求 / 响应 body。峰值内存同样只由最大帧决定。
+ *
+ * @tparam T - FlatBuffers 生成的 Table 类型
+ */
+template<typename T>
+class FrameSink : public oatpp::data::stream::OutputStream {
+public:
+  /**
+   * 返回 false 表示中止：本次 write 失败，之后的字节全部拒绝。
+   */
+  using Callback = std::function<bool(const Object<T>&)>;
+private:
+  std::shared_ptr<ObjectMapper> m_mapper;
+  Callback m_callback;
+  v_buff_size m_maxFrameSize;
+  oatpp::data::stream::IOMode m_ioMode = oatpp::data::stream::IOMode::ASYNCHRONOUS;
+  uint8_t m_prefix[4];
+  v_buff_size m_prefixFilled = 0;
+  oatpp::String m_frame;
+  v_buff_size m_filled = 0;
+  v_int64 m_frameCount = 0;
+  bool m_failed = false;
+private:
+
+  bool onFrame() {
+    oatpp::utils::parser::Caret caret(m_frame);
+    if (!m_mapper->getConfig().sizePrefixed) {
+      caret.setPosition(4);
+    }
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = m_mapper->read(caret, Object<T>::Class::getType(), errorStack);
+    m_frame = nullptr;
+    m_filled = 0;
+    m_prefixFilled = 0;
+    if (!errorStack.empty() || !value) {
+      return false;
+    }
+    ++m_frameCount;
+    return m_callback(value.template cast<Object<T>>());
+  }
+
+public:
+
+  /**
+   * Constructor.
+   * @param mapper - 用于构造 `Object<T>` 的 ObjectMapper（是否 sizePrefixed 均可）。
+   * @param callback - 每帧回调。
+   * @param maxFrameSize - 单帧上限（不含前缀），超过即失败。
+   */
+  FrameSink(const std::shared_ptr<ObjectMapper>& mapper,
+            const Callback& callback,
+            v_buff_size maxFrameSize = 16 * 1024 * 1024)
+    : m_mapper(mapper)
+    , m_callback(callback)
+    , m_maxFrameSize(maxFrameSize)
+  {}
+
+  v_io_size write(const void* data, v_buff_size count, async::Action& action) override {
+    (void) action;
+    if (m_failed) {
+      return oatpp::IOError::BROKEN_PIPE;
+    }
+    auto in = static_cast<const uint8_t*>(data);
+    v_buff_size consumed = 0;
+    while (consumed < count) {
+      if (m_prefixFilled < 4) {
+        v_buff_size n = std::min<v_buff_size>(4 - m_prefixFilled, count - consumed);
+        std::memcpy(m_prefix + m_prefixFilled, in + consumed, static_cast<size_t>(n));
+        m_prefixFilled += n;
+        consumed += n;
+        if (m_prefixFilled < 4) break;
+        v_buff_size frameSize = static_cast<v_buff_size>(::flatbuffers::GetPrefixedSize(m_prefix));
+        if (frameSize < 4 || frameSize > m_maxFrameSize) {
+          m_failed = true;
+          return oatpp::IOError::BROKEN_PIPE;
+        }
+        m_frame = oatpp::String(frameSize + 4);
+        std::memcpy(&m_frame->front(), m_prefix, 4);
+        m_filled = 4;
+      }
+      v_buff_size n = std::min<v_buff_size>(static_cast<v_buff_size>(m_frame->size()) - m_filled, count - consumed);
+      std::memcpy(&m_frame->front() + m_filled, in + consumed, static_cast<size_t>(n));
+      m_filled += n;
+      consumed += n;
+      if (m_filled == static_cast<v_buff_size>(m_frame->size()) && !onFrame()) {
+        m_failed = true;
+        return oatpp::IOError::BROKEN_PIPE;
+      }
+    }
+    return count;
+  }
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    m_ioMode = ioMode;
+  }
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override {
+    return m_ioMode;
+  }
+
+  oatpp::data::stream::Context& getOutputStreamContext() override {
+    static oatpp::data::stream::DefaultInitializedContext context(oatpp::data::stream::StreamType::STREAM_INFINITE);
+    return context;
+  }
+
+  /**
+   * 已成功解码的帧数。
+   */
+  v_int64 getFrameCount() const {
+    return m_frameCount;
+  }
+
+  /**
+   * 流在帧边界结束且未出错。
+   */
+  bool isComplete() const {
+    return !m_failed && m_prefixFilled == 0;
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_FRAME_SINK_HPP */
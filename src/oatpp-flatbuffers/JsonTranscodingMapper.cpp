@@ -0,0 +1,226 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "JsonTranscodingMapper.hpp"
+
+#include "flatbuffers/idl.h"
+
+namespace oatpp { namespace flatbuffers {
+
+JsonTranscodingMapper::ParserHandle::ParserHandle(const JsonTranscodingMapper* mapper, PooledParser&& pooled)
+  : m_mapper(mapper)
+  , m_pooled(std::move(pooled))
+{}
+
+JsonTranscodingMapper::ParserHandle::~ParserHandle() {
+  if (m_pooled.parser) {
+    m_mapper->releaseParser(std::move(m_pooled));
+  }
+}
+
+JsonTranscodingMapper::JsonTranscodingMapper(const uint8_t* schema, v_buff_size schemaSize, const Config& config)
+  : data::mapping::ObjectMapper(getMapperInfo())
+  , m_config(config)
+  , m_schema(reinterpret_cast<const char*>(schema), static_cast<size_t>(schemaSize))
+{}
+
+std::shared_ptr<JsonTranscodingMapper> JsonTranscodingMapper::createShared(const uint8_t* schema, v_buff_size schemaSize,
+                                                                           const Config& config) {
+  return std::make_shared<JsonTranscodingMapper>(schema, schemaSize, config);
+}
+
+void JsonTranscodingMapper::bindRootType(const oatpp::Type* type, const std::string& qualifiedName) {
+  m_rootTypes[type] = qualifiedName;
+}
+
+const JsonTranscodingMapper::Config& JsonTranscodingMapper::getConfig() const {
+  return m_config;
+}
+
+std::unique_ptr<JsonTranscodingMapper::ParserHandle> JsonTranscodingMapper::acquireParser() const {
+  {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    if (!m_parsers.empty()) {
+      PooledParser pooled = std::move(m_parsers.back());
+      m_parsers.pop_back();
+      return std::unique_ptr<ParserHandle>(new ParserHandle(this, std::move(pooled)));
+    }
+  }
+
+  ::flatbuffers::IDLOptions opts;
+  opts.strict_json = m_config.strictJson;
+  opts.indent_step = m_config.indentStep;
+  opts.output_default_scalars_in_json = m_config.outputDefaults;
+  opts.output_enum_identifiers = m_config.outputEnumIdentifiers;
+
+  PooledParser pooled;
+  pooled.parser.reset(new ::flatbuffers::Parser(opts));
+  if (!pooled.parser->Deserialize(reinterpret_cast<const uint8_t*>(m_schema.data()), m_schema.size())) {
+    return nullptr;
+  }
+  pooled.defaultRoot = pooled.parser->root_struct_def_;
+  return std::unique_ptr<ParserHandle>(new ParserHandle(this, std::move(pooled)));
+}
+
+void JsonTranscodingMapper::releaseParser(PooledParser&& pooled) const {
+  pooled.parser->builder_.Clear();
+  std::lock_guard<std::mutex> lock(m_poolMutex);
+  if (static_cast<v_int32>(m_parsers.size()) < m_config.maxPooledParsers) {
+    m_parsers.push_back(std::move(pooled));
+  }
+}
+
+bool JsonTranscodingMapper::selectRootType(const ParserHandle& handle, const oatpp::Type* type) const {
+  auto it = m_rootTypes.find(type);
+  if (it != m_rootTypes.end()) {
+    return handle.get()->SetRootType(it->second.c_str());
+  }
+  handle.get()->root_struct_def_ = handle.getDefaultRoot();
+  return handle.getDefaultRoot() != nullptr;
+}
+
+void JsonTranscodingMapper::write(data::stream::ConsistentOutputStream* stream,
+                                  const oatpp::Void& variant,
+                                  data::mapping::ErrorStack& errorStack) const {
+
+  if (!variant) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Variant is null");
+    return;
+  }
+
+  const auto* vt = variant.getValueType();
+  if (!vt || !vt->extends(AbstractFlatBuffersObject::Class::getType())) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Variant is not a FlatBuffers object");
+    return;
+  }
+
+  auto raw = static_cast<const AbstractFlatBuffersObject*>(variant.get());
+  if (!raw || !raw->getBufferData() || raw->getBufferSize() < 4) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Empty flatbuffers buffer");
+    return;
+  }
+  // GenerateText 不做边界检查，延迟校验的对象必须先完成校验
+  if (!raw->ensureVerified()) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: FlatBuffers verification failed");
+    return;
+  }
+
+  auto parser = acquireParser();
+  if (!parser) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Failed to load binary schema");
+    return;
+  }
+  if (!selectRootType(*parser, raw->getWrapperType())) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Unknown root type");
+    return;
+  }
+
+  thread_local std::string json;
+  json.clear();
+  if (!::flatbuffers::GenerateText(*parser->get(), raw->getBufferData(), &json)) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Failed to generate JSON");
+    return;
+  }
+  if (stream->writeSimple(json.data(), static_cast<v_buff_size>(json.size())) != static_cast<v_io_size>(json.size())) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::write()]: Failed to write all data");
+  }
+
+}
+
+oatpp::Void JsonTranscodingMapper::read(oatpp::utils::parser::Caret& caret,
+                                        const oatpp::Type* type,
+                                        data::mapping::ErrorStack& errorStack) const {
+
+  if (!type || !type->extends(AbstractFlatBuffersObject::Class::getType())) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: Type is not a FlatBuffers object");
+    return nullptr;
+  }
+
+  v_buff_size position = caret.getPosition();
+  v_buff_size available = caret.getDataSize() - position;
+  if (available <= 0) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: No data available");
+    return nullptr;
+  }
+
+  auto parser = acquireParser();
+  if (!parser) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: Failed to load binary schema");
+    return nullptr;
+  }
+
+  const bool any = type == AbstractFlatBuffersObject::Class::getType();
+  if (!selectRootType(*parser, any ? nullptr : type)) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: Unknown root type");
+    return nullptr;
+  }
+
+  // Parser 需要以 '\0' 结尾的输入；线程内复用同一块暂存区
+  thread_local std::string text;
+  text.assign(caret.getData() + position, static_cast<size_t>(available));
+
+  // ParseJson 只接受一个 JSON 值，不会把请求体当作 schema 修改池中的 parser
+  auto* p = parser->get();
+  p->builder_.Clear();
+  if (!p->ParseJson(text.c_str())) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: " + p->error_);
+    return nullptr;
+  }
+  caret.setPosition(position + available);
+
+  const oatpp::Type* targetType = type;
+  if (any) {
+    // AnyObject：按 schema 的 file_identifier 找到注册的具体类型
+    if (p->file_identifier_.size() != ::flatbuffers::kFileIdentifierLength) {
+      errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: Schema has no file_identifier");
+      return nullptr;
+    }
+    targetType = FlatBuffersTypeRegistry::instance().findTypeByFileIdentifier(p->file_identifier_.c_str());
+    if (!targetType) {
+      errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: No type registered for schema file_identifier");
+      return nullptr;
+    }
+  }
+
+  auto entry = FlatBuffersTypeRegistry::instance().findEntry(targetType);
+  if (!entry || !entry->factory) {
+    errorStack.push("[oatpp::flatbuffers::JsonTranscodingMapper::read()]: No factory registered for requested FlatBuffers type");
+    return nullptr;
+  }
+
+  // 单次分配拷出 builder 的输出，builder 保留容量随 parser 回到池中
+  FlatBuffersBufferSource source;
+  source.borrowData = p->builder_.GetBufferPointer();
+  source.borrowSize = static_cast<v_buff_size>(p->builder_.GetSize());
+  source.inlineCopy = true;
+  auto result = entry->factory(source);
+  if (targetType != type) {
+    return oatpp::Void(result.getPtr(), type);
+  }
+  return result;
+
+}
+
+}}
@@ -0,0 +1,199 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef OATPP_FLATBUFFERS_JSON_TRANSCODING_MAPPER_HPP
+#define OATPP_FLATBUFFERS_JSON_TRANSCODING_MAPPER_HPP
+
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+#include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+#include "oatpp/Types.hpp"
+
+#include "flatbuffers/idl.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * JSON <-> FlatBuffers transcoding ObjectMapper (`application/json`).
+ * Reads JSON bodies straight into a `FlatBufferBuilder` and writes `Object<T>` back as JSON,
+ * driven by a binary schema (`.bfbs`), without an intermediate oatpp DTO tree.
+ *
+ * The schema is deserialized once per pooled `::flatbuffers::Parser`; the parser keeps the
+ * per-field offset and type tables (`StructDef` / `FieldDef`) it builds from it, so a request
+ * only pays for tokenizing the JSON and writing the buffer. Parsers are not thread-safe and are
+ * handed out from an internal pool.
+ *
+ * Register it next to &id:oatpp::flatbuffers::ObjectMapper; in `ContentMappers` so the same
+ * endpoints serve both binary and browser clients.
+ *
+ * Extends &id:oatpp::base::Countable;, &id:oatpp::data::mapping::ObjectMapper;.
+ */
+class JsonTranscodingMapper : public oatpp::base::Countable, public oatpp::data::mapping::ObjectMapper {
+public:
+
+  /**
+   * Mapper configuration.
+   */
+  class Config {
+  public:
+
+    /**
+     * Quote field names in generated JSON.
+     */
+    bool strictJson = true;
+
+    /**
+     * Indentation step of generated JSON; `-1` writes everything on one line.
+     */
+    v_int32 indentStep = -1;
+
+    /**
+     * Emit scalar fields that are equal to their default value.
+     */
+    bool outputDefaults = false;
+
+    /**
+     * Emit enum values by name instead of by number.
+     */
+    bool outputEnumIdentifiers = true;
+
+    /**
+     * Maximum number of parsers kept in the pool.
+     */
+    v_int32 maxPooledParsers = 64;
+
+  };
+
+private:
+
+  struct PooledParser {
+    std::unique_ptr<::flatbuffers::Parser> parser;
+    // Deserialize() 设置的 schema root_type，未绑定的类型回退到它
+    ::flatbuffers::StructDef* defaultRoot = nullptr;
+  };
+
+  class ParserHandle {
+  private:
+    const JsonTranscodingMapper* m_mapper;
+    PooledParser m_pooled;
+  public:
+    ParserHandle(const JsonTranscodingMapper* mapper, PooledParser&& pooled);
+    ~ParserHandle();
+    ParserHandle(const ParserHandle&) = delete;
+    ParserHandle& operator=(const ParserHandle&) = delete;
+    ::flatbuffers::Parser* get() const { return m_pooled.parser.get(); }
+    ::flatbuffers::StructDef* getDefaultRoot() const { return m_pooled.defaultRoot; }
+  };
+
+private:
+  static Info getMapperInfo() {
+    return Info("application", "json");
+  }
+private:
+  Config m_config;
+  std::string m_schema;
+  std::unordered_map<const oatpp::Type*, std::string> m_rootTypes;
+  mutable std::mutex m_poolMutex;
+  mutable std::vector<PooledParser> m_parsers;
+private:
+  std::unique_ptr<ParserHandle> acquireParser() const;
+  void releaseParser(PooledParser&& pooled) const;
+  bool selectRootType(const ParserHandle& handle, const oatpp::Type* type) const;
+public:
+
+  /**
+   * Constructor.
+   * @param schema - binary schema (`.bfbs`) bytes.
+   * @param schemaSize - size of the schema.
+   * @param config - &l:JsonTranscodingMapper::Config;.
+   */
+  JsonTranscodingMapper(const uint8_t* schema, v_buff_size schemaSize, const Config& config = Config());
+
+  /**
+   * Create shared JsonTranscodingMapper.
+   * @param schema - binary schema (`.bfbs`) bytes.
+   * @param schemaSize - size of the schema.
+   * @param config - &l:JsonTranscodingMapper::Config;.
+   * @return - `std::shared_ptr` to JsonTranscodingMapper.
+   */
+  static std::shared_ptr<JsonTranscodingMapper> createShared(const uint8_t* schema, v_buff_size schemaSize,
+                                                             const Config& config = Config());
+
+  /**
+   * Bind a wrapper type to a fully qualified table name of the schema (e.g. `MyGame.Example.Monster`).
+   * Types that are not bound use the schema `root_type`. Bind all types before the mapper is shared.
+   * @param type - `Object<T>::Class::getType()`.
+   * @param qualifiedName - table name.
+   */
+  void bindRootType(const oatpp::Type* type, const std::string& qualifiedName);
+
+  /**
+   * Typed form of &l:JsonTranscodingMapper::bindRootType ();.
+   */
+  template<typename T>
+  void bindRootType(const std::string& qualifiedName) {
+    bindRootType(Object<T>::Class::getType(), qualifiedName);
+  }
+
+  /**
+   * Get config.
+   * @return - &l:JsonTranscodingMapper::Config;.
+   */
+  const Config& getConfig() const;
+
+  /**
+   * Write a FlatBuffers object as JSON.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param variant - FlatBuffers object (`Object<T>` / `AnyObject`).
+   * @param errorStack - See &id:oatpp::data::mapping::ErrorStack;.
+   */
+  void write(data::stream::ConsistentOutputStream* stream,
+             const oatpp::Void& variant,
+             data::mapping::ErrorStack& errorStack) const override;
+
+  /**
+   * Parse the remaining caret content as JSON into a FlatBuffers object of `type`.
+   * @param caret - &id:oatpp::utils::parser::Caret; over the JSON text.
+   * @param type - `Object<T>::Class::getType()`.
+   * @param errorStack - See &id:oatpp::data::mapping::ErrorStack;.
+   * @return - deserialized object wrapped in &id:oatpp::Void;.
+   */
+  oatpp::Void read(oatpp::utils::parser::Caret& caret,
+                   const oatpp::Type* type,
+                   data::mapping::ErrorStack& errorStack) const override;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_JSON_TRANSCODING_MAPPER_HPP */
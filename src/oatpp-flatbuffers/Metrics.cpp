@@ -0,0 +1,337 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Metrics.hpp"
+
+#include "FlatBuffersWrapper.hpp"
+#include "BufferPool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+// 单写者计数：只有所属线程会写，relaxed load + store 即可，读方最多看到稍旧的值
+inline void bump(std::atomic<v_int64>& value, v_int64 delta) {
+  value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+struct ThreadShard {
+  MapperMetrics::Shard* shard = nullptr;
+  ~ThreadShard() {
+    if (shard) {
+      MapperMetrics::instance().retireShard(shard);
+    }
+  }
+};
+
+thread_local ThreadShard t_shard;
+
+std::string typeName(const oatpp::data::type::Type* type) {
+  if (!type) return "unknown";
+  auto entry = FlatBuffersTypeRegistry::instance().findEntry(type);
+  if (entry && !entry->name.empty()) return entry->name;
+  return type->classId.name ? type->classId.name : "unknown";
+}
+
+std::string escapeLabel(const std::string& value) {
+  std::string result;
+  result.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '\\': result += "\\\\"; break;
+      case '"': result += "\\\""; break;
+      case '\n': result += "\\n"; break;
+      default: result += c;
+    }
+  }
+  return result;
+}
+
+}
+
+// 一个线程上一个类型的计数；只追加到分片链表头部，分片存活期间不删除
+struct MapperMetrics::Slot {
+  const oatpp::data::type::Type* type;
+  Slot* next;
+  std::atomic<v_int64> counters[COUNTER_COUNT];
+  std::atomic<v_int64> readSizes[SIZE_BUCKET_COUNT];
+  std::atomic<v_int64> writeSizes[SIZE_BUCKET_COUNT];
+
+  Slot(const oatpp::data::type::Type* slotType, Slot* nextSlot)
+    : type(slotType)
+    , next(nextSlot)
+  {
+    for (auto& value : counters) value.store(0, std::memory_order_relaxed);
+    for (auto& value : readSizes) value.store(0, std::memory_order_relaxed);
+    for (auto& value : writeSizes) value.store(0, std::memory_order_relaxed);
+  }
+
+  void addTo(TypeStatistics& stats) const {
+    for (v_int32 i = 0; i < COUNTER_COUNT; ++i) {
+      stats.counters[i] += counters[i].load(std::memory_order_relaxed);
+    }
+    for (v_int32 i = 0; i < SIZE_BUCKET_COUNT; ++i) {
+      stats.readSizes[i] += readSizes[i].load(std::memory_order_relaxed);
+      stats.writeSizes[i] += writeSizes[i].load(std::memory_order_relaxed);
+    }
+  }
+};
+
+struct MapperMetrics::Shard {
+  std::atomic<Slot*> head {nullptr};
+  // 仅所属线程访问
+  Slot* last = nullptr;
+
+  ~Shard() {
+    Slot* slot = head.load(std::memory_order_relaxed);
+    while (slot) {
+      Slot* next = slot->next;
+      delete slot;
+      slot = next;
+    }
+  }
+};
+
+const MapperMetrics::TypeStatistics* MapperMetrics::Snapshot::find(const std::string& name) const {
+  for (const auto& stats : types) {
+    if (stats.name == name) return &stats;
+  }
+  return nullptr;
+}
+
+MapperMetrics& MapperMetrics::instance() {
+  // 永不析构：线程退出时 t_shard 仍会调用 retireShard()，可能晚于静态对象析构（如 main 返回后才结束的线程）
+  static MapperMetrics* metrics = new MapperMetrics;
+  return *metrics;
+}
+
+v_int64 MapperMetrics::getSizeBucketBound(v_int32 index) {
+  if (index < 0 || index >= SIZE_BUCKET_COUNT - 1) return -1;
+  return v_int64(64) << (2 * index);
+}
+
+v_int32 MapperMetrics::getSizeBucket(v_buff_size size) {
+  v_int32 index = 0;
+  v_int64 bound = 64;
+  while (index < SIZE_BUCKET_COUNT - 1 && size > bound) {
+    ++index;
+    bound <<= 2;
+  }
+  return index;
+}
+
+MapperMetrics::Slot* MapperMetrics::slot(const oatpp::data::type::Type* type) {
+  Shard* shard = t_shard.shard;
+  if (!shard) {
+    shard = new Shard();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_shards.push_back(shard);
+    }
+    t_shard.shard = shard;
+  }
+  if (shard->last && shard->last->type == type) {
+    return shard->last;
+  }
+  for (Slot* s = shard->head.load(std::memory_order_relaxed); s; s = s->next) {
+    if (s->type == type) {
+      shard->last = s;
+      return s;
+    }
+  }
+  // 发布新 Slot：release 保证 snapshot() 看到的是已初始化的计数
+  Slot* s = new Slot(type, shard->head.load(std::memory_order_relaxed));
+  shard->head.store(s, std::memory_order_release);
+  shard->last = s;
+  return s;
+}
+
+void MapperMetrics::recordRead(const oatpp::data::type::Type* type, v_buff_size size, bool borrowed) {
+  Slot* s = slot(type);
+  bump(s->counters[borrowed ? READS_BORROWED : READS_COPIED], 1);
+  bump(s->counters[READ_BYTES], size);
+  bump(s->readSizes[getSizeBucket(size)], 1);
+}
+
+void MapperMetrics::recordReadError(const oatpp::data::type::Type* type) {
+  bump(slot(type)->counters[READ_ERRORS], 1);
+}
+
+void MapperMetrics::recordWrite(const oatpp::data::type::Type* type, v_buff_size size) {
+  Slot* s = slot(type);
+  bump(s->counters[WRITES], 1);
+  bump(s->counters[WRITE_BYTES], size);
+  bump(s->writeSizes[getSizeBucket(size)], 1);
+}
+
+void MapperMetrics::recordWriteError(const oatpp::data::type::Type* type) {
+  bump(slot(type)->counters[WRITE_ERRORS], 1);
+}
+
+void MapperMetrics::recordVerify(const oatpp::data::type::Type* type, v_int64 nanos, bool ok) {
+  Slot* s = slot(type);
+  bump(s->counters[VERIFICATIONS], 1);
+  bump(s->counters[VERIFY_NANOS], nanos);
+  if (!ok) {
+    bump(s->counters[VERIFY_FAILURES], 1);
+  }
+}
+
+void MapperMetrics::retireShard(Shard* shard) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Slot* s = shard->head.load(std::memory_order_acquire); s; s = s->next) {
+      auto& stats = m_retired[s->type];
+      stats.type = s->type;
+      s->addTo(stats);
+    }
+    m_shards.erase(std::remove(m_shards.begin(), m_shards.end(), shard), m_shards.end());
+  }
+  delete shard;
+}
+
+MapperMetrics::Snapshot MapperMetrics::snapshot() {
+  std::unordered_map<const oatpp::data::type::Type*, TypeStatistics> totals;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    totals = m_retired;
+    for (auto* shard : m_shards) {
+      for (Slot* s = shard->head.load(std::memory_order_acquire); s; s = s->next) {
+        auto& stats = totals[s->type];
+        stats.type = s->type;
+        s->addTo(stats);
+      }
+    }
+  }
+  Snapshot result;
+  result.types.reserve(totals.size());
+  for (auto& pair : totals) {
+    pair.second.name = typeName(pair.first);
+    result.types.push_back(std::move(pair.second));
+  }
+  std::sort(result.types.begin(), result.types.end(), [](const TypeStatistics& a, const TypeStatistics& b) {
+    return a.name < b.name;
+  });
+  return result;
+}
+
+std::string MapperMetrics::toPrometheusText(const Snapshot& snapshot) {
+  std::string out;
+  auto family = [&out](const char* name, const char* type, const char* help) {
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+  };
+  auto sample = [&out](const char* name, const char* suffix, const std::string& labels, const std::string& value) {
+    out.append(name).append(suffix);
+    if (!labels.empty()) {
+      out.append("{").append(labels).append("}");
+    }
+    out.append(" ").append(value).append("\n");
+  };
+  auto typeLabel = [](const TypeStatistics& stats) {
+    return "type=\"" + escapeLabel(stats.name) + "\"";
+  };
+  auto histogram = [&](const char* name, const char* help, Counter sumCounter, bool reads) {
+    family(name, "histogram", help);
+    for (const auto& stats : snapshot.types) {
+      v_int64 count = reads ? stats.getReads() : stats.get(WRITES);
+      if (count == 0) continue;
+      const v_int64* counts = reads ? stats.readSizes : stats.writeSizes;
+      v_int64 cumulative = 0;
+      for (v_int32 i = 0; i < SIZE_BUCKET_COUNT; ++i) {
+        cumulative += counts[i];
+        v_int64 bound = getSizeBucketBound(i);
+        sample(name, "_bucket", typeLabel(stats) + ",le=\"" + (bound < 0 ? std::string("+Inf") : std::to_string(bound)) + "\"",
+               std::to_string(cumulative));
+      }
+      sample(name, "_sum", typeLabel(stats), std::to_string(stats.get(sumCounter)));
+      sample(name, "_count", typeLabel(stats), std::to_string(count));
+    }
+  };
+
+  family("oatpp_flatbuffers_reads_total", "counter",
+         "Objects read by the FlatBuffers ObjectMapper, by whether the body was borrowed or copied.");
+  for (const auto& stats : snapshot.types) {
+    if (stats.getReads() == 0) continue;
+    sample("oatpp_flatbuffers_reads_total", "", typeLabel(stats) + ",mode=\"borrow\"", std::to_string(stats.get(READS_BORROWED)));
+    sample("oatpp_flatbuffers_reads_total", "", typeLabel(stats) + ",mode=\"copy\"", std::to_string(stats.get(READS_COPIED)));
+  }
+
+  family("oatpp_flatbuffers_read_errors_total", "counter", "Bodies rejected by the FlatBuffers ObjectMapper.");
+  for (const auto& stats : snapshot.types) {
+    if (stats.get(READ_ERRORS) == 0) continue;
+    sample("oatpp_flatbuffers_read_errors_total", "", typeLabel(stats), std::to_string(stats.get(READ_ERRORS)));
+  }
+
+  family("oatpp_flatbuffers_writes_total", "counter", "Objects written by the FlatBuffers ObjectMapper.");
+  for (const auto& stats : snapshot.types) {
+    if (stats.get(WRITES) == 0) continue;
+    sample("oatpp_flatbuffers_writes_total", "", typeLabel(stats), std::to_string(stats.get(WRITES)));
+  }
+
+  family("oatpp_flatbuffers_write_errors_total", "counter", "Writes failed in the FlatBuffers ObjectMapper.");
+  for (const auto& stats : snapshot.types) {
+    if (stats.get(WRITE_ERRORS) == 0) continue;
+    sample("oatpp_flatbuffers_write_errors_total", "", typeLabel(stats), std::to_string(stats.get(WRITE_ERRORS)));
+  }
+
+  family("oatpp_flatbuffers_verifications_total", "counter", "Typed buffer verifications, eager and deferred.");
+  for (const auto& stats : snapshot.types) {
+    if (stats.get(VERIFICATIONS) == 0) continue;
+    sample("oatpp_flatbuffers_verifications_total", "", typeLabel(stats) + ",result=\"ok\"",
+           std::to_string(stats.get(VERIFICATIONS) - stats.get(VERIFY_FAILURES)));
+    sample("oatpp_flatbuffers_verifications_total", "", typeLabel(stats) + ",result=\"failed\"",
+           std::to_string(stats.get(VERIFY_FAILURES)));
+  }
+
+  family("oatpp_flatbuffers_verify_seconds_total", "counter", "Time spent in typed buffer verification.");
+  for (const auto& stats : snapshot.types) {
+    if (stats.get(VERIFICATIONS) == 0) continue;
+    char seconds[32];
+    std::snprintf(seconds, sizeof(seconds), "%.9f", static_cast<double>(stats.get(VERIFY_NANOS)) / 1e9);
+    sample("oatpp_flatbuffers_verify_seconds_total", "", typeLabel(stats), seconds);
+  }
+
+  histogram("oatpp_flatbuffers_read_size_bytes", "Size of bodies read by the FlatBuffers ObjectMapper.",
+            READ_BYTES, true);
+  histogram("oatpp_flatbuffers_write_size_bytes", "Size of buffers written by the FlatBuffers ObjectMapper.",
+            WRITE_BYTES, false);
+
+  family("oatpp_flatbuffers_pinned_bytes", "gauge", "Bytes of request bodies kept alive by borrowed objects.");
+  sample("oatpp_flatbuffers_pinned_bytes", "", "", std::to_string(AbstractFlatBuffersObject::getPinnedBytes()));
+
+  auto pool = BufferPool::instance().getStatistics();
+  family("oatpp_flatbuffers_buffer_pool_total", "counter", "BufferPool acquisitions and releases.");
+  sample("oatpp_flatbuffers_buffer_pool_total", "", "result=\"hit\"", std::to_string(pool.hits));
+  sample("oatpp_flatbuffers_buffer_pool_total", "", "result=\"miss\"", std::to_string(pool.misses));
+  sample("oatpp_flatbuffers_buffer_pool_total", "", "result=\"recycled\"", std::to_string(pool.recycled));
+  sample("oatpp_flatbuffers_buffer_pool_total", "", "result=\"discarded\"", std::to_string(pool.discarded));
+
+  return out;
+}
+
+}}
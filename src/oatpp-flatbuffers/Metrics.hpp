@@ -0,0 +1,164 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_METRICS_HPP
+#define OATPP_FLATBUFFERS_METRICS_HPP
+
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * ObjectMapper 的运行指标，按注册类型分别统计：
+ * - 读/写次数与字节数，读取时 borrow 与拷贝各多少，读写错误，校验次数、失败与耗时；
+ * - 读写大小直方图。
+ *
+ * 每个线程只写自己的分片，计数是单写者的 relaxed load + store，没有 RMW 也不加锁。
+ * 线程首次记录时在锁下登记分片，之后按类型查找只走本线程的链表，并缓存最近一次命中的类型。
+ * 线程退出时分片并入累计值，计数单调递增，适合 Prometheus 抓取。
+ *
+ * 类型名取自 &id:oatpp::flatbuffers::FlatBuffersTypeRegistry;（T 的限定名），
+ * 未注册的类型用 oatpp 的 class id。
+ */
+class MapperMetrics {
+public:
+
+  /**
+   * 计数器。
+   */
+  enum Counter : v_int32 {
+    READS_BORROWED = 0,
+    READS_COPIED,
+    READ_BYTES,
+    READ_ERRORS,
+    WRITES,
+    WRITE_BYTES,
+    WRITE_ERRORS,
+    VERIFICATIONS,
+    VERIFY_FAILURES,
+    VERIFY_NANOS,
+    COUNTER_COUNT
+  };
+
+  /**
+   * 大小直方图的格数：上界从 64B 起按 4 倍递增到 64MB，最后一格为 +Inf。
+   */
+  static constexpr v_int32 SIZE_BUCKET_COUNT = 12;
+
+  /**
+   * 单个类型的汇总值；直方图按格计数（非累计）。
+   */
+  struct TypeStatistics {
+    const oatpp::data::type::Type* type = nullptr;
+    std::string name;
+    v_int64 counters[COUNTER_COUNT] = {};
+    v_int64 readSizes[SIZE_BUCKET_COUNT] = {};
+    v_int64 writeSizes[SIZE_BUCKET_COUNT] = {};
+
+    v_int64 get(Counter counter) const {
+      return counters[counter];
+    }
+
+    v_int64 getReads() const {
+      return counters[READS_BORROWED] + counters[READS_COPIED];
+    }
+  };
+
+  /**
+   * `snapshot()` 的结果，`types` 按名字排序。
+   */
+  struct Snapshot {
+    std::vector<TypeStatistics> types;
+
+    /**
+     * 按名字查找；不存在返回 nullptr。
+     */
+    const TypeStatistics* find(const std::string& name) const;
+  };
+
+  /**
+   * 线程分片（内部使用）。
+   */
+  struct Shard;
+
+private:
+  std::mutex m_mutex;
+  std::vector<Shard*> m_shards;
+  std::unordered_map<const oatpp::data::type::Type*, TypeStatistics> m_retired;
+private:
+  MapperMetrics() = default;
+  struct Slot;
+  Slot* slot(const oatpp::data::type::Type* type);
+  static v_int32 getSizeBucket(v_buff_size size);
+public:
+  MapperMetrics(const MapperMetrics&) = delete;
+  MapperMetrics& operator=(const MapperMetrics&) = delete;
+
+  static MapperMetrics& instance();
+
+  /**
+   * 自 `start` 起经过的纳秒数。
+   */
+  static v_int64 nanosSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  /**
+   * 直方图第 `index` 格的上界（字节）；最后一格返回 -1，表示 +Inf。
+   */
+  static v_int64 getSizeBucketBound(v_int32 index);
+
+  void recordRead(const oatpp::data::type::Type* type, v_buff_size size, bool borrowed);
+  void recordReadError(const oatpp::data::type::Type* type);
+  void recordWrite(const oatpp::data::type::Type* type, v_buff_size size);
+  void recordWriteError(const oatpp::data::type::Type* type);
+  void recordVerify(const oatpp::data::type::Type* type, v_int64 nanos, bool ok);
+
+  /**
+   * 汇总所有线程分片与已退出线程的累计值。
+   */
+  Snapshot snapshot();
+
+  /**
+   * 以 Prometheus 文本格式（0.0.4）输出 `snapshot`，另附 BufferPool 命中统计与借用对象钉住的字节数。
+   */
+  static std::string toPrometheusText(const Snapshot& snapshot);
+
+  /**
+   * 线程退出时并入累计值（内部使用）。
+   */
+  void retireShard(Shard* shard);
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_METRICS_HPP */
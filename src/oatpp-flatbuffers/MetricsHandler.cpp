@@ -0,0 +1,66 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "MetricsHandler.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/async/Coroutine.hpp"
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+class RespondWith : public oatpp::async::CoroutineWithResult<RespondWith, const std::shared_ptr<MetricsHandler::OutgoingResponse>&> {
+private:
+  std::shared_ptr<MetricsHandler::OutgoingResponse> m_response;
+public:
+  explicit RespondWith(const std::shared_ptr<MetricsHandler::OutgoingResponse>& response)
+    : m_response(response)
+  {}
+
+  Action act() override {
+    return _return(m_response);
+  }
+};
+
+}
+
+std::shared_ptr<MetricsHandler::OutgoingResponse> MetricsHandler::handle(const std::shared_ptr<IncomingRequest>& request) {
+  (void) request;
+  auto text = MapperMetrics::toPrometheusText(MapperMetrics::instance().snapshot());
+  auto response = oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(Status::CODE_200, oatpp::String(text));
+  response->putHeader(oatpp::web::protocol::http::Header::CONTENT_TYPE, CONTENT_TYPE);
+  return response;
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<MetricsHandler::OutgoingResponse>&>
+MetricsHandler::handleAsync(const std::shared_ptr<IncomingRequest>& request) {
+  return RespondWith::startForResult(handle(request));
+}
+
+void MetricsHandler::addToRouter(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const char* path) {
+  router->route("GET", path, std::make_shared<MetricsHandler>());
+}
+
+}}
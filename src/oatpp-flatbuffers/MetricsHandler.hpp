@@ -0,0 +1,62 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_METRICS_HANDLER_HPP
+#define OATPP_FLATBUFFERS_METRICS_HANDLER_HPP
+
+#include "Metrics.hpp"
+
+#include "oatpp/web/server/HttpRequestHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+
+#include <memory>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 可选的指标端点：`GET` 时以 Prometheus 文本格式返回 &id:oatpp::flatbuffers::MapperMetrics; 的快照。
+ * 同时支持同步与异步连接处理器；用 `addToRouter()` 挂到路由上即可，不需要 ApiController。
+ */
+class MetricsHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+  static constexpr const char* CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override;
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override;
+
+  /**
+   * 注册 `GET <path>`。
+   * @param router - 路由器。
+   * @param path - 端点路径，默认 `/metrics`。
+   */
+  static void addToRouter(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const char* path = "/metrics");
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_METRICS_HANDLER_HPP */
@@ -25,46 +25,110 @@
 #include "ObjectMapper.hpp"
 
 #include "FlatBuffersWrapper.hpp"
+#include "Arena.hpp"
+#include "BufferPool.hpp"
+#include "BuilderPool.hpp"
+#include "Metrics.hpp"
 #include "flatbuffers/base.h"
-#include "flatbuffers/verifier.h"
 
+#include <chrono>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <memory>
 
 namespace oatpp { namespace flatbuffers {
 
-ObjectMapper::ObjectMapper()
+ObjectMapper::ObjectMapper(const Config& config)
   : data::mapping::ObjectMapper(getMapperInfo())
+  , m_config(config)
 {}
 
-void ObjectMapper::writeBinaryData(data::stream::ConsistentOutputStream* stream,
+const ObjectMapper::Config& ObjectMapper::getConfig() const {
+  return m_config;
+}
+
+std::shared_ptr<::flatbuffers::FlatBufferBuilder> ObjectMapper::acquireBuilder() const {
+  return BuilderPool::instance().acquire(m_config.builderInitialSize);
+}
+
+std::shared_ptr<const std::vector<uint8_t>> ObjectMapper::copyBuffer(const uint8_t* data, v_buff_size size) const {
+  if (m_config.useBufferPool) {
+    return BufferPool::instance().copyOf(data, size);
+  }
+  return std::make_shared<std::vector<uint8_t>>(data, data + size);
+}
+
+void ObjectMapper::recordRead(const oatpp::Type* type,
+                              const oatpp::Void& result,
+                              const FlatBuffersBufferSource& source,
+                              v_buff_size consumed) const {
+  if (!m_config.collectMetrics) {
+    return;
+  }
+  auto& metrics = MapperMetrics::instance();
+  if (!result) {
+    metrics.recordReadError(type);
+    return;
+  }
+  if (type->extends(AbstractFlatBuffersObject::Class::getType())) {
+    // 按具体 T 统计（按 file_identifier 分发的读取也归到实际类型）
+    auto object = static_cast<const AbstractFlatBuffersObject*>(result.get());
+    metrics.recordRead(object->getWrapperType(), consumed, source.anchor || source.keepAlive);
+    return;
+  }
+  metrics.recordRead(type, consumed, false);
+}
+
+bool ObjectMapper::writeBinaryData(data::stream::ConsistentOutputStream* stream,
                                    const void* data,
                                    v_buff_size size,
                                    data::mapping::ErrorStack& errorStack) const {
   
   if (!data || size == 0) {
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::writeBinaryData()]: Invalid data or size");
-    return;
+    return false;
+  }
+
+  if (m_config.sizePrefixed) {
+    uint8_t prefix[sizeof(::flatbuffers::uoffset_t)];
+    ::flatbuffers::WriteScalar<::flatbuffers::uoffset_t>(prefix, static_cast<::flatbuffers::uoffset_t>(size));
+    if (stream->writeSimple(prefix, sizeof(prefix)) != sizeof(prefix)) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::writeBinaryData()]: Failed to write size prefix");
+      return false;
+    }
   }
   
   v_io_size written = stream->writeSimple(data, size);
   if (written != size) {
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::writeBinaryData()]: Failed to write all data");
-    return;
+    return false;
   }
+  return true;
 }
 
 void ObjectMapper::write(data::stream::ConsistentOutputStream* stream,
                          const oatpp::Void& variant,
                          data::mapping::ErrorStack& errorStack) const {
   
+  const auto* vt = variant.getValueType();
+  const v_buff_size prefixSize = m_config.sizePrefixed ? static_cast<v_buff_size>(sizeof(::flatbuffers::uoffset_t)) : 0;
+  auto record = [&](const oatpp::Type* type, v_buff_size size, bool ok) {
+    if (!m_config.collectMetrics) return;
+    if (ok) {
+      MapperMetrics::instance().recordWrite(type, size + prefixSize);
+    } else {
+      MapperMetrics::instance().recordWriteError(type);
+    }
+  };
+
   if (!variant) {
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::write()]: Variant is null");
+    record(vt, 0, false);
     return;
   }
   
   // 优先：FlatBuffers 包装对象（任意 T），类型应当继承自 AbstractFlatBuffersObject。
-  const auto* vt = variant.getValueType();
   if (vt && vt->extends(AbstractFlatBuffersObject::Class::getType())) {
     // 注意：oatpp 的 ObjectWrapper::cast 要求“目标类型 extends 源类型”，
     // 这里我们做上行转换（子 -> 父），因此不能用 cast。改为通过别名 shared_ptr 获取基类指针。
@@ -73,11 +137,12 @@ void ObjectMapper::write(data::stream::ConsistentOutputStream* stream,
       const uint8_t* data = raw->getBufferData();
       v_buff_size size = raw->getBufferSize();
       if (data && size > 0) {
-        writeBinaryData(stream, data, size, errorStack);
+        record(raw->getWrapperType(), size, writeBinaryData(stream, data, size, errorStack));
         return;
       }
     }
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::write()]: Empty flatbuffers buffer");
+    record(vt, 0, false);
     return;
   }
   
@@ -86,98 +151,258 @@ void ObjectMapper::write(data::stream::ConsistentOutputStream* stream,
   if (ptr) {
     const auto* buffer = static_cast<const std::vector<uint8_t>*>(ptr.get());
     if (buffer && !buffer->empty()) {
-      writeBinaryData(stream, buffer->data(), static_cast<v_buff_size>(buffer->size()), errorStack);
+      auto size = static_cast<v_buff_size>(buffer->size());
+      record(vt, size, writeBinaryData(stream, buffer->data(), size, errorStack));
       return;
     }
   }
   
   errorStack.push("[oatpp::flatbuffers::ObjectMapper::write()]: Unsupported variant type for flatbuffers serialization");
+  record(vt, 0, false);
 }
 
 oatpp::Void ObjectMapper::read(oatpp::utils::parser::Caret& caret,
                                 const oatpp::Type* type,
                                 data::mapping::ErrorStack& errorStack) const {
+  return read(caret, type, nullptr, errorStack);
+}
+
+oatpp::Void ObjectMapper::read(oatpp::utils::parser::Caret& caret,
+                                const oatpp::Type* type,
+                                const std::shared_ptr<Arena>& arena,
+                                data::mapping::ErrorStack& errorStack) const {
   
   if (!type) {
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: Type is null");
     return nullptr;
   }
+
+  if (isBatchType(type)) {
+    return readBatch(caret, type, errorStack);
+  }
   
   // Get remaining data from caret
   const char* data = caret.getData();
   v_buff_size totalSize = caret.getDataSize();
   v_buff_size position = caret.getPosition();
   
+  FlatBuffersBufferSource source;
   if (totalSize == 0 || position >= totalSize) {
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: No data available");
+    recordRead(type, nullptr, source, 0);
     return nullptr;
   }
   
-  // Calculate available data size
-  v_buff_size available = totalSize - position;
-  
+  source.anchor = caret.getDataMemoryHandle();
+  source.anchorSize = totalSize;
+  source.arena = arena;
+  v_buff_size consumed = 0;
+  auto result = readRegion(reinterpret_cast<const uint8_t*>(data + position), totalSize - position,
+                           source, type, consumed, errorStack);
+  recordRead(type, result, source, consumed);
+
+  // Update caret position once the region has been accepted
+  if (consumed > 0) {
+    caret.setPosition(position + consumed);
+  }
+  return result;
+}
+
+bool ObjectMapper::isBatchType(const oatpp::Type* type) {
+  if (type->classId.id != data::type::__class::AbstractList::CLASS_ID.id &&
+      type->classId.id != data::type::__class::AbstractVector::CLASS_ID.id) {
+    return false;
+  }
+  auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto itemType = dispatcher ? dispatcher->getItemType() : nullptr;
+  return itemType && itemType->extends(AbstractFlatBuffersObject::Class::getType());
+}
+
+oatpp::Void ObjectMapper::readBatch(oatpp::utils::parser::Caret& caret,
+                                    const oatpp::Type* type,
+                                    data::mapping::ErrorStack& errorStack) const {
+  auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto itemType = dispatcher->getItemType();
+  auto collection = dispatcher->createObject();
+
+  const char* data = caret.getData();
+  v_buff_size totalSize = caret.getDataSize();
+  v_buff_size position = caret.getPosition();
+  auto anchor = caret.getDataMemoryHandle();
+
+  // 逐帧切分（校验延迟，交给 BatchProcessor 并行完成）；任一帧格式非法则整批拒绝，Caret 不移动
+  while (position < totalSize) {
+    FlatBuffersBufferSource source;
+    source.anchor = anchor;
+    source.anchorSize = totalSize;
+    v_buff_size consumed = 0;
+    auto item = readRegion(reinterpret_cast<const uint8_t*>(data + position), totalSize - position,
+                           source, itemType, consumed, errorStack, true);
+    recordRead(itemType, item, source, consumed);
+    if (!item) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::readBatch()]: Invalid batch item #" +
+                      std::to_string(dispatcher->getCollectionSize(collection)));
+      return nullptr;
+    }
+    dispatcher->addItem(collection, item);
+    position += consumed;
+  }
+  caret.setPosition(position);
+  return collection;
+}
+
+oatpp::Void ObjectMapper::readFromBuffer(const std::shared_ptr<std::vector<uint8_t>>& buffer,
+                                          const oatpp::Type* type,
+                                          data::mapping::ErrorStack& errorStack,
+                                          const std::shared_ptr<Arena>& arena) const {
+  if (!type) {
+    errorStack.push("[oatpp::flatbuffers::ObjectMapper::readFromBuffer()]: Type is null");
+    return nullptr;
+  }
+  if (!buffer || buffer->empty()) {
+    errorStack.push("[oatpp::flatbuffers::ObjectMapper::readFromBuffer()]: No data available");
+    return nullptr;
+  }
+  FlatBuffersBufferSource source;
+  source.keepAlive = buffer;
+  source.arena = arena;
+  v_buff_size consumed = 0;
+  auto result = readRegion(buffer->data(), static_cast<v_buff_size>(buffer->size()), source, type, consumed, errorStack);
+  recordRead(type, result, source, consumed);
+  return result;
+}
+
+oatpp::Void ObjectMapper::readRegion(const uint8_t* buffer,
+                                     v_buff_size available,
+                                     FlatBuffersBufferSource& source,
+                                     const oatpp::Type* type,
+                                     v_buff_size& consumed,
+                                     data::mapping::ErrorStack& errorStack,
+                                     bool batchItem) const {
+
   // For flatbuffers, we need at least 4 bytes (root offset)
   if (available < 4) {
     errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: Buffer too small (minimum 4 bytes)");
     return nullptr;
   }
   
-  // Get the buffer data
-  const uint8_t* buffer = reinterpret_cast<const uint8_t*>(data + position);
-  
-  // For flatbuffers, we need to determine the actual buffer size
   // FlatBuffers buffers can have:
-  // 1. Size prefix (4 bytes) + data
-  // 2. Just data (no size prefix)
-  
+  // 1. Size prefix (4 bytes) + data - sizePrefixed mode, exactly one frame is consumed
+  // 2. Just data (no size prefix) - the whole remainder is consumed
   v_buff_size bufferSize = available;
-  
-  // Try to read size prefix if present
-  // FlatBuffers may use size-prefixed buffers
-  if (available >= 4) {
-    // Check if first 4 bytes look like a size prefix
-    // Size prefix is typically the size of the buffer (excluding the prefix itself)
-    v_uint32 sizePrefix = ::flatbuffers::ReadScalar<v_uint32>(buffer);
-    if (sizePrefix > 0 && sizePrefix < available && sizePrefix + 4 <= available) {
-      // This might be a size prefix
-      // But we need to verify it's actually a flatbuffers buffer
-      // For now, we'll use the full available size
-      // In practice, you might want to verify the buffer structure
+  v_buff_size regionSize = available;
+  v_buff_size prefixBytes = 0;
+
+  if (m_config.sizePrefixed || batchItem) {
+    // 等价于 GetSizePrefixedRoot：根表位于前缀之后，这里直接把前缀后的区间作为独立 buffer 交给工厂
+    v_buff_size sizePrefix = static_cast<v_buff_size>(::flatbuffers::GetPrefixedSize(buffer));
+    if (sizePrefix < 4 || sizePrefix > available - 4) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: Invalid or incomplete size prefix");
+      return nullptr;
     }
+    buffer += 4;
+    bufferSize = sizePrefix;
+    regionSize = sizePrefix + 4;
+    prefixBytes = 4;
   }
   
-  // Verify the buffer is a valid flatbuffers buffer
-  // Use flatbuffers::Verifier to check buffer validity
-  ::flatbuffers::Verifier verifier(buffer, bufferSize);
-  // Note: We don't verify here because we don't know the root table type
-  // Verification should be done by the user when they call GetRoot<T>
-  
-  // Update caret position before building the result (consume entire remainder)
-  caret.setPosition(position + bufferSize);
-
   const bool wantsFlatBuffersObject = type->extends(AbstractFlatBuffersObject::Class::getType());
 
+  // 请求的是抽象基类：按 buffer 4..8 字节的 file_identifier 分发到已注册的具体类型
+  const oatpp::Type* targetType = type;
+  if (type == AbstractFlatBuffersObject::Class::getType()) {
+    if (bufferSize < 8) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: Buffer too small to carry a file_identifier");
+      return nullptr;
+    }
+    targetType = FlatBuffersTypeRegistry::instance().findTypeByFileIdentifier(::flatbuffers::GetBufferIdentifier(buffer));
+    if (!targetType) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: No type registered for buffer file_identifier");
+      return nullptr;
+    }
+  }
+
+  const FlatBuffersTypeRegistry::Entry* entry = nullptr;
   if (wantsFlatBuffersObject) {
-    FlatBuffersBufferSource source;
-    auto anchor = caret.getDataMemoryHandle();
-    if (anchor) {
-      source.anchor = std::move(anchor);
-      source.borrowData = buffer;
-      source.borrowSize = bufferSize;
+    entry = FlatBuffersTypeRegistry::instance().findEntry(targetType);
+    if (!entry || !entry->factory) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: No factory registered for requested FlatBuffers type");
+      return nullptr;
+    }
+  }
+
+  // 类型化校验：在消费 Caret 之前拒绝非法字节，避免进入业务协程；
+  // size-prefixed 的帧从前缀起校验，对齐检查才以 builder 的基准为准
+  const bool deferVerify = m_config.lazyVerify || batchItem;
+  if (wantsFlatBuffersObject && m_config.verify && !deferVerify && entry->verify) {
+    bool verified;
+    if (m_config.collectMetrics) {
+      auto start = std::chrono::steady_clock::now();
+      verified = entry->verify(buffer - prefixBytes, regionSize, m_config.verifyOptions, prefixBytes > 0);
+      MapperMetrics::instance().recordVerify(targetType, MapperMetrics::nanosSince(start), verified);
     } else {
-      source.owned = std::make_shared<std::vector<uint8_t>>(buffer, buffer + bufferSize);
+      verified = entry->verify(buffer - prefixBytes, regionSize, m_config.verifyOptions, prefixBytes > 0);
     }
-    auto factory = FlatBuffersTypeRegistry::instance().findFactory(type);
-    if (factory) {
-      return factory(source);
+    if (!verified) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: FlatBuffers verification failed");
+      return nullptr;
     }
-    errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: No factory registered for requested FlatBuffers type");
-    return nullptr;
+  }
+
+  if (wantsFlatBuffersObject) {
+    if (m_config.verify && deferVerify && entry->verify) {
+      source.deferredVerify = &m_config.verifyOptions;
+      source.collectMetrics = m_config.collectMetrics;
+    }
+    source.borrowData = buffer;
+    source.borrowSize = bufferSize;
+    source.prefixBytes = prefixBytes;
+    // FlatBuffers 的对齐以整段输出（含 size prefix）为基准，且整段长度是 builder minalign 的整数倍，
+    // 由此得到本段实际需要的对齐：尾部不满足时（如 force_align: 8 的 struct 落在奇数偏移）不借用，
+    // 改走下面的拷贝；拷贝连同前缀从对齐的起点开始，尾部也就同样对齐
+    bool copyInstead = false;
+    v_buff_size required = m_config.alignment;
+    while (required > 1 && (regionSize & (required - 1)) != 0) {
+      required >>= 1;
+    }
+    if (required > 1) {
+      auto mask = static_cast<uintptr_t>(required - 1);
+      copyInstead = (reinterpret_cast<uintptr_t>(buffer + bufferSize) & mask) != 0;
+    }
+    // 保留策略：小区间不为它钉住整块 body
+    if (source.anchor && !batchItem && m_config.compactRatio > 0 && source.anchorSize / m_config.compactRatio > bufferSize) {
+      copyInstead = true;
+    }
+    if (copyInstead) {
+      source.anchor = nullptr;
+      source.keepAlive = nullptr;
+    }
+    const bool borrowed = source.anchor || source.keepAlive;
+    // 调用方显式给出了请求 Arena 时，拷贝与包装对象都从中分配（见 wrapSource）
+    if (!borrowed && !source.arena) {
+      if (bufferSize <= m_config.inlineCopyThreshold) {
+        source.inlineCopy = true;
+      } else {
+        source.owned = copyBuffer(buffer - prefixBytes, regionSize);
+      }
+    }
+    auto result = entry->factory(source);
+    if (!result) {
+      errorStack.push("[oatpp::flatbuffers::ObjectMapper::read()]: Failed to create FlatBuffers object");
+      return nullptr;
+    }
+    consumed = regionSize;
+    if (targetType != type) {
+      // 以请求的抽象类型返回，调用方通过 AnyObject::as<T>() 取回具体对象
+      return oatpp::Void(result.getPtr(), type);
+    }
+    return result;
   }
 
   // 非 FlatBuffers 包装类型：始终使用独立拷贝，不依赖 Caret 寿命
-  auto bufferCopy = std::make_shared<std::vector<uint8_t>>(buffer, buffer + bufferSize);
-  return oatpp::Void(bufferCopy);
+  auto bufferCopy = copyBuffer(buffer, bufferSize);
+  consumed = regionSize;
+  return oatpp::Void(std::const_pointer_cast<std::vector<uint8_t>>(bufferCopy));
 }
 
 }}
@@ -25,6 +25,8 @@
 #ifndef OATPP_FLATBUFFERS_OBJECTMAPPER_HPP
 #define OATPP_FLATBUFFERS_OBJECTMAPPER_HPP
 
+#include "FlatBuffersWrapper.hpp"
+
 #include "oatpp/data/mapping/ObjectMapper.hpp"
 #include "oatpp/data/stream/Stream.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
@@ -43,17 +45,114 @@ namespace oatpp { namespace flatbuffers {
  * Extends &id:oatpp::base::Countable;, &id:oatpp::data::mapping::ObjectMapper;.
  */
 class ObjectMapper : public oatpp::base::Countable, public oatpp::data::mapping::ObjectMapper {
+public:
+
+  /**
+   * Mapper configuration.
+   */
+  class Config {
+  public:
+
+    /**
+     * Run the typed verifier (`VerifyBuffer<T>`) registered for the requested type
+     * before the object is handed out. Buffers failing verification are rejected in `read()`.
+     */
+    bool verify = true;
+
+    /**
+     * Limits passed to `::flatbuffers::Verifier` (max depth, max tables) and the maximum accepted buffer size.
+     */
+    FlatBuffersVerifyOptions verifyOptions;
+
+    /**
+     * Defer verification (requires `verify`) until the first field access through
+     * `Object<T>::operator->()` / `getMutable()`. The result is cached in the object, so buffers
+     * that are only forwarded are never verified and deep readers verify exactly once.
+     * A failed deferred verification throws `std::runtime_error` from the accessor.
+     */
+    bool lazyVerify = false;
+
+    /**
+     * Required alignment (power of two, up to 16), capped by what the region's own length implies
+     * (builders pad buffers to their minimum alignment). FlatBuffers aligns fields relative to the end
+     * of the buffer, so a borrowed region is used in place only if its end is aligned; otherwise,
+     * e.g. for a frame behind an odd offset, it is copied into storage whose end is aligned.
+     * `force_align` structs and wide scalars are then never read through a misaligned pointer.
+     * Set to `0` or `1` to always borrow.
+     */
+    v_buff_size alignment = 8;
+
+    /**
+     * Retention policy for the borrowed path. When `> 0`, a region whose underlying body
+     * (caret memory handle) is more than `compactRatio` times larger than the region itself
+     * is copied into an exactly sized buffer instead of pinning the whole body.
+     * Objects kept beyond the request can be detached explicitly with `Object<T>::compacted()`.
+     * See `AbstractFlatBuffersObject::getPinnedBytes()` for the bytes currently pinned.
+     */
+    v_int32 compactRatio = 0;
+
+    /**
+     * Size-prefixed framing. When `true`, `read()` expects a 4-byte little-endian length prefix,
+     * consumes exactly `prefix + 4` bytes and leaves the rest of the caret unread, so several
+     * messages can be packed into one body. `write()` emits the prefix in front of every buffer.
+     */
+    bool sizePrefixed = false;
+
+    /**
+     * When the caret has no memory handle, copy the body into a buffer taken from
+     * &id:oatpp::flatbuffers::BufferPool; instead of a freshly allocated vector.
+     * The buffer returns to the pool when the last object referencing it is destroyed.
+     */
+    bool useBufferPool = true;
+
+    /**
+     * Owned copies up to this size (in bytes) are made with a single allocation that holds
+     * the object wrapper, its reference count and the FlatBuffer bytes (see `FlatBuffersWrapper<T>::fromBytes()`).
+     * Larger copies go through the buffer pool. Set to `0` to disable.
+     */
+    v_buff_size inlineCopyThreshold = 64 * 1024;
+
+    /**
+     * Initial capacity of builders created by &l:ObjectMapper::acquireBuilder (); when the pool is empty.
+     */
+    v_buff_size builderInitialSize = 1024;
+
+    /**
+     * Record reads, writes, bytes, borrow/copy decisions, errors and eager verification time
+     * per registered type in &id:oatpp::flatbuffers::MapperMetrics;. Deferred verification is
+     * recorded by the object when it runs, if this flag was set when the object was read.
+     */
+    bool collectMetrics = true;
+
+  };
+
 private:
   static Info getMapperInfo() {
     return Info("application", "x-flatbuffers");
   }
-
+private:
+  Config m_config;
 public:
   
   /**
    * Constructor.
+   * @param config - &l:ObjectMapper::Config;.
+   */
+  ObjectMapper(const Config& config = Config());
+
+  /**
+   * Get mapper config.
+   * @return - &l:ObjectMapper::Config;.
+   */
+  const Config& getConfig() const;
+
+  /**
+   * Take a cleared builder from the thread-local &id:oatpp::flatbuffers::BuilderPool;.
+   * Wrap the finished output with `Object<T>::fromPooledBuilder()`; the builder returns to the pool
+   * when the last reference is released.
+   * @return - builder.
    */
-  ObjectMapper();
+  std::shared_ptr<::flatbuffers::FlatBufferBuilder> acquireBuilder() const;
   
   /**
    * Serialize object to stream.
@@ -67,6 +166,10 @@ public:
   
   /**
    * Deserialize object from stream.
+   * A `List<Object<T>>` / `Vector<Object<T>>` type reads a batch body: size-prefixed buffers back to back
+   * (regardless of &l:ObjectMapper::Config::sizePrefixed;), all borrowing the same body. Batch items always
+   * defer verification (when `verify` is on), so it can be spread across threads, e.g. by
+   * &id:oatpp::flatbuffers::BatchProcessor;.
    * @param caret - &id:oatpp::utils::parser::Caret; over serialized buffer.
    * @param type - pointer to object type. See &id:oatpp::data::type::Type;.
    * @param errorStack - See &id:oatpp::data::mapping::ErrorStack;.
@@ -76,7 +179,87 @@ public:
                    const oatpp::Type* type, 
                    data::mapping::ErrorStack& errorStack) const override;
 
+  /**
+   * Same as &l:ObjectMapper::read (); with an explicit per-request arena.
+   * When the read has to copy (the caret has no memory handle, or the region is misaligned or compacted),
+   * the copy and the wrapper object are allocated from `arena`; borrowed reads are not affected.
+   * The arena is passed explicitly (e.g. a member of the endpoint coroutine), so the call may sit anywhere
+   * in a coroutine, across yields and executor threads.
+   * @param caret - &id:oatpp::utils::parser::Caret; over serialized buffer.
+   * @param type - pointer to object type. See &id:oatpp::data::type::Type;.
+   * @param arena - &id:oatpp::flatbuffers::Arena; for copies; `nullptr` - same as &l:ObjectMapper::read ();.
+   * @param errorStack - See &id:oatpp::data::mapping::ErrorStack;.
+   * @return - deserialized object wrapped in &id:oatpp::Void;.
+   */
+  oatpp::Void read(oatpp::utils::parser::Caret& caret,
+                   const oatpp::Type* type,
+                   const std::shared_ptr<Arena>& arena,
+                   data::mapping::ErrorStack& errorStack) const;
+
+  /**
+   * Deserialize object from an owned buffer (e.g. pooled storage filled by &id:oatpp::flatbuffers::AlignedBodyReader;).
+   * The resulting object borrows `buffer` and keeps it alive; same framing, verification and
+   * alignment rules as &l:ObjectMapper::read ();.
+   * @param buffer - buffer holding the serialized object.
+   * @param type - pointer to object type. See &id:oatpp::data::type::Type;.
+   * @param errorStack - See &id:oatpp::data::mapping::ErrorStack;.
+   * @param arena - &id:oatpp::flatbuffers::Arena; for the copy when the buffer cannot be borrowed; may be `nullptr`.
+   * @return - deserialized object wrapped in &id:oatpp::Void;.
+   */
+  oatpp::Void readFromBuffer(const std::shared_ptr<std::vector<uint8_t>>& buffer,
+                             const oatpp::Type* type,
+                             data::mapping::ErrorStack& errorStack,
+                             const std::shared_ptr<Arena>& arena = nullptr) const;
+
 private:
+
+  /**
+   * Shared part of `read()` / `readFromBuffer()`: framing, type dispatch, verification and
+   * the choice between borrowing (`source.anchor` / `source.keepAlive`) and copying.
+   * @param consumed - set to the number of bytes taken once the region is accepted.
+   * @param batchItem - item of a batch body: always size-prefixed, verification deferred,
+   * retention policy skipped (the body is shared by every item anyway).
+   */
+  oatpp::Void readRegion(const uint8_t* buffer,
+                         v_buff_size available,
+                         FlatBuffersBufferSource& source,
+                         const oatpp::Type* type,
+                         v_buff_size& consumed,
+                         data::mapping::ErrorStack& errorStack,
+                         bool batchItem = false) const;
+
+  /**
+   * Read a batch body into a `List` / `Vector` of FlatBuffers objects.
+   * @return - collection, or nullptr (with `errorStack` set) if any item is invalid.
+   */
+  oatpp::Void readBatch(oatpp::utils::parser::Caret& caret,
+                        const oatpp::Type* type,
+                        data::mapping::ErrorStack& errorStack) const;
+
+  /**
+   * `List` / `Vector` whose item type is a FlatBuffers object.
+   */
+  static bool isBatchType(const oatpp::Type* type);
+
+  /**
+   * Copy buffer for the owned path (pooled or plain vector, see &l:ObjectMapper::Config::useBufferPool;).
+   * @param data - Pointer to flatbuffers binary data.
+   * @param size - Size of the data in bytes.
+   * @return - owned copy.
+   */
+  std::shared_ptr<const std::vector<uint8_t>> copyBuffer(const uint8_t* data, v_buff_size size) const;
+
+  /**
+   * Record the outcome of `readRegion()` in &id:oatpp::flatbuffers::MapperMetrics; (when enabled).
+   * @param type - requested type.
+   * @param result - object returned by `readRegion()`, nullptr on error.
+   * @param source - source after `readRegion()`: borrowed when `anchor` or `keepAlive` is still set.
+   * @param consumed - bytes taken from the body.
+   */
+  void recordRead(const oatpp::Type* type,
+                  const oatpp::Void& result,
+                  const FlatBuffersBufferSource& source,
+                  v_buff_size consumed) const;
   
   /**
    * Helper method to write flatbuffers binary data to stream.
@@ -84,8 +267,9 @@ private:
    * @param data - Pointer to flatbuffers binary data.
    * @param size - Size of the data in bytes.
    * @param errorStack - Error stack.
+   * @return - `true` if all bytes (and the size prefix) were written.
    */
-  void writeBinaryData(data::stream::ConsistentOutputStream* stream,
+  bool writeBinaryData(data::stream::ConsistentOutputStream* stream,
                        const void* data,
                        v_buff_size size,
                        data::mapping::ErrorStack& errorStack) const;
@@ -0,0 +1,331 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Projection.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+// flatc 为 union 字段 `foo` 生成的类型字段名为 `foo_type`
+const char* const UNION_TYPE_SUFFIX = "_type";
+
+const reflection::Object& objectAt(const reflection::Schema& schema, v_int32 index) {
+  return *schema.objects()->Get(static_cast<::flatbuffers::uoffset_t>(index));
+}
+
+::flatbuffers::uoffset_t copyVector(::flatbuffers::FlatBufferBuilder& builder,
+                                    const reflection::Schema& schema,
+                                    const SchemaFieldInfo& field,
+                                    const ::flatbuffers::Table& table)
+{
+  switch (field.elementType) {
+    case reflection::String: {
+      auto source = table.GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>*>(field.offset);
+      std::vector<::flatbuffers::Offset<::flatbuffers::String>> elements(source->size());
+      for (::flatbuffers::uoffset_t i = 0; i < source->size(); ++i) {
+        elements[i] = builder.CreateString(source->Get(i));
+      }
+      return builder.CreateVector(elements).o;
+    }
+    case reflection::Obj:
+      if (!field.object->isStruct) {
+        auto source = table.GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::Table>>*>(field.offset);
+        auto& elementDef = *field.object->object;
+        std::vector<::flatbuffers::Offset<const ::flatbuffers::Table*>> elements(source->size());
+        for (::flatbuffers::uoffset_t i = 0; i < source->size(); ++i) {
+          elements[i] = ::flatbuffers::CopyTable(builder, schema, elementDef, *source->Get(i));
+        }
+        return builder.CreateVector(elements).o;
+      }
+      FLATBUFFERS_FALLTHROUGH();
+    default: {
+      // 标量与 struct 向量：整段字节拷贝
+      auto source = table.GetPointer<const ::flatbuffers::VectorOfAny*>(field.offset);
+      size_t elementSize = ::flatbuffers::GetTypeSize(field.elementType);
+      size_t elementAlignment = elementSize;
+      if (field.elementType == reflection::Obj) {
+        elementSize = static_cast<size_t>(field.object->byteSize);
+        elementAlignment = static_cast<size_t>(field.object->object->minalign());
+      }
+      builder.ForceVectorAlignment(source->size(), elementSize, elementAlignment);
+      builder.StartVector(source->size(), elementSize);
+      builder.PushBytes(source->Data(), elementSize * source->size());
+      return builder.EndVector(source->size());
+    }
+  }
+}
+
+}
+
+std::shared_ptr<const ProjectionPlan> ProjectionPlan::compile(const std::shared_ptr<const CompiledSchema>& schema,
+                                                              const SchemaObjectInfo* object,
+                                                              const std::vector<std::string>& fields)
+{
+  if (!schema || !object || object->isStruct) {
+    return nullptr;
+  }
+  std::shared_ptr<ProjectionPlan> plan(new ProjectionPlan());
+  plan->m_schema = schema;
+  plan->m_object = object;
+
+  std::vector<const SchemaFieldInfo*> selected;
+  for (const auto& name : fields) {
+    auto field = object->findField(name);
+    if (field == nullptr) {
+      return nullptr;
+    }
+    selected.push_back(field);
+    // union 的值离不开它的类型字段
+    if (field->baseType == reflection::Union) {
+      auto typeField = object->findField(name + UNION_TYPE_SUFFIX);
+      if (typeField == nullptr) {
+        return nullptr;
+      }
+      selected.push_back(typeField);
+    }
+  }
+  std::sort(selected.begin(), selected.end());
+  selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+  for (auto field : selected) {
+    FieldPlan fieldPlan {field, 0, 0, nullptr, 0};
+    switch (field->baseType) {
+      case reflection::Obj:
+        if (field->object == nullptr) {
+          return nullptr;
+        }
+        if (field->object->isStruct) {
+          fieldPlan.size = static_cast<v_uint16>(field->object->byteSize);
+          fieldPlan.alignment = static_cast<v_uint16>(field->object->object->minalign());
+          plan->m_inlineFields.push_back(fieldPlan);
+        } else {
+          plan->m_offsetFields.push_back(fieldPlan);
+        }
+        break;
+      case reflection::Union: {
+        auto typeField = object->findField(field->name + UNION_TYPE_SUFFIX);
+        fieldPlan.unionEnum = schema->getSchema()->enums()->Get(static_cast<::flatbuffers::uoffset_t>(field->field->type()->index()));
+        fieldPlan.unionTypeOffset = typeField->offset;
+        plan->m_offsetFields.push_back(fieldPlan);
+        break;
+      }
+      case reflection::Vector:
+        if (field->elementType == reflection::Union ||
+            (field->elementType == reflection::Obj && field->object == nullptr)) {
+          return nullptr;
+        }
+        plan->m_offsetFields.push_back(fieldPlan);
+        break;
+      case reflection::String:
+        plan->m_offsetFields.push_back(fieldPlan);
+        break;
+      default:
+        fieldPlan.size = static_cast<v_uint16>(::flatbuffers::GetTypeSize(field->baseType));
+        fieldPlan.alignment = fieldPlan.size;
+        plan->m_inlineFields.push_back(fieldPlan);
+        break;
+    }
+  }
+
+  // 大字段在前，减少 table 内的对齐填充
+  std::stable_sort(plan->m_inlineFields.begin(), plan->m_inlineFields.end(), [](const FieldPlan& a, const FieldPlan& b) {
+    return a.alignment > b.alignment;
+  });
+  return plan;
+}
+
+const SchemaObjectInfo* ProjectionPlan::getObject() const {
+  return m_object;
+}
+
+bool ProjectionPlan::isInlineOnly() const {
+  return m_offsetFields.empty();
+}
+
+::flatbuffers::uoffset_t ProjectionPlan::copyOffsetField(::flatbuffers::FlatBufferBuilder& builder,
+                                                         const ::flatbuffers::Table& table,
+                                                         const FieldPlan& plan) const
+{
+  const auto& field = *plan.field;
+  const auto& schema = *m_schema->getSchema();
+  switch (field.baseType) {
+    case reflection::String:
+      return builder.CreateString(table.GetPointer<const ::flatbuffers::String*>(field.offset)).o;
+    case reflection::Obj:
+      return ::flatbuffers::CopyTable(builder, schema, *field.object->object,
+                                      *table.GetPointer<const ::flatbuffers::Table*>(field.offset)).o;
+    case reflection::Union: {
+      auto unionType = table.GetField<uint8_t>(plan.unionTypeOffset, 0);
+      auto value = plan.unionEnum->values()->LookupByKey(unionType);
+      if (value == nullptr || value->union_type() == nullptr || value->union_type()->index() < 0) {
+        return 0;
+      }
+      return ::flatbuffers::CopyTable(builder, schema, objectAt(schema, value->union_type()->index()),
+                                      *table.GetPointer<const ::flatbuffers::Table*>(field.offset)).o;
+    }
+    case reflection::Vector:
+      return copyVector(builder, schema, field, table);
+    default:
+      return 0;
+  }
+}
+
+::flatbuffers::Offset<::flatbuffers::Table> ProjectionPlan::encode(::flatbuffers::FlatBufferBuilder& builder,
+                                                                   const ::flatbuffers::Table& table) const
+{
+  // 子对象必须在 StartTable 之前写完
+  std::vector<::flatbuffers::uoffset_t> offsets;
+  if (!m_offsetFields.empty()) {
+    offsets.resize(m_offsetFields.size(), 0);
+    for (size_t i = 0; i < m_offsetFields.size(); ++i) {
+      if (table.CheckField(m_offsetFields[i].field->offset)) {
+        offsets[i] = copyOffsetField(builder, table, m_offsetFields[i]);
+      }
+    }
+  }
+
+  auto start = builder.StartTable();
+  for (const auto& plan : m_inlineFields) {
+    auto data = table.GetStruct<const uint8_t*>(plan.field->offset);
+    if (data == nullptr) continue;
+    builder.Align(plan.alignment);
+    builder.PushBytes(data, plan.size);
+    builder.TrackField(plan.field->offset, builder.GetSize());
+  }
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    if (offsets[i] != 0) {
+      builder.AddOffset(m_offsetFields[i].field->offset, ::flatbuffers::Offset<void>(offsets[i]));
+    }
+  }
+  return ::flatbuffers::Offset<::flatbuffers::Table>(builder.EndTable(start));
+}
+
+void ProjectionPlan::apply(::flatbuffers::FlatBufferBuilder& builder, const uint8_t* buffer) const {
+  auto root = encode(builder, *::flatbuffers::GetAnyRoot(buffer));
+  auto schema = m_schema->getSchema();
+  auto identifier = schema->file_ident();
+  if (identifier && identifier->size() == ::flatbuffers::FlatBufferBuilder::kFileIdentifierLength &&
+      m_object == m_schema->getRootObject() &&
+      ::flatbuffers::BufferHasIdentifier(buffer, identifier->c_str())) {
+    builder.Finish(root, identifier->c_str());
+  } else {
+    builder.Finish(root);
+  }
+}
+
+Projector::Projector(const std::shared_ptr<const CompiledSchema>& schema, v_int32 maxPlans)
+  : m_schema(schema)
+  , m_maxPlans(maxPlans)
+{}
+
+std::shared_ptr<Projector> Projector::createShared(const std::shared_ptr<const CompiledSchema>& schema, v_int32 maxPlans) {
+  return std::make_shared<Projector>(schema, maxPlans);
+}
+
+void Projector::bindType(const oatpp::Type* type, const std::string& qualifiedName) {
+  auto object = m_schema ? m_schema->findObject(qualifiedName) : nullptr;
+  if (object == nullptr || object->isStruct) {
+    throw std::runtime_error("[oatpp::flatbuffers::Projector::bindType()]: Unknown table '" + qualifiedName + "'");
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_types[type] = object;
+}
+
+const SchemaObjectInfo* Projector::findBoundObject(const oatpp::Type* type) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_types.find(type);
+    if (it != m_types.end()) {
+      return it->second;
+    }
+  }
+  return m_schema ? m_schema->getRootObject() : nullptr;
+}
+
+std::vector<std::string> Projector::parseFieldList(const std::string& fields) {
+  std::vector<std::string> result;
+  size_t begin = 0;
+  while (begin <= fields.size()) {
+    size_t end = fields.find(',', begin);
+    if (end == std::string::npos) end = fields.size();
+    size_t first = begin;
+    size_t last = end;
+    while (first < last && std::isspace(static_cast<unsigned char>(fields[first]))) ++first;
+    while (last > first && std::isspace(static_cast<unsigned char>(fields[last - 1]))) --last;
+    if (last > first) {
+      result.emplace_back(fields, first, last - first);
+    }
+    begin = end + 1;
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::shared_ptr<const ProjectionPlan> Projector::getPlan(const SchemaObjectInfo* object, const std::string& fields) {
+  if (object == nullptr) {
+    return nullptr;
+  }
+  auto names = parseFieldList(fields);
+  std::string key = object->name;
+  for (const auto& name : names) {
+    key.push_back('\n');
+    key.append(name);
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_plans.find(key);
+    if (it != m_plans.end()) {
+      return it->second;
+    }
+  }
+  auto plan = ProjectionPlan::compile(m_schema, object, names);
+  if (plan) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (static_cast<v_int32>(m_plans.size()) < m_maxPlans) {
+      m_plans.emplace(key, plan);
+    }
+  }
+  return plan;
+}
+
+std::shared_ptr<const ProjectionPlan> Projector::projectBuffer(const oatpp::Type* type,
+                                                               const oatpp::String& fields,
+                                                               const AbstractFlatBuffersObject& source,
+                                                               ::flatbuffers::FlatBufferBuilder& builder)
+{
+  auto plan = getPlan(findBoundObject(type), *fields);
+  if (!plan || !source.ensureVerified()) {
+    return nullptr;
+  }
+  plan->apply(builder, source.getBufferData());
+  return plan;
+}
+
+}}
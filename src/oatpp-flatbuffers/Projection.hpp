@@ -0,0 +1,169 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_PROJECTION_HPP
+#define OATPP_FLATBUFFERS_PROJECTION_HPP
+
+#include "SchemaCache.hpp"
+#include "BuilderPool.hpp"
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/Types.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 一个 (table 类型, 字段集合) 的投影计划：编译时已按字段种类分组，
+ * 编码时只按偏移拷贝被选中的字段，未选中的子树完全不触碰。
+ * - 标量与 struct 字段直接按字节 memcpy 进新 table；只含这类字段的计划跳过
+ *   子对象构造阶段，代价与字段字节数成正比。
+ * - string / vector / 子 table / union 字段整棵深拷贝（reflection::CopyTable）。
+ */
+class ProjectionPlan {
+private:
+  struct FieldPlan {
+    const SchemaFieldInfo* field;
+    v_uint16 size;
+    v_uint16 alignment;
+    // union 字段：类型枚举与对应 `<name>_type` 字段的 vtable 槽位
+    const reflection::Enum* unionEnum;
+    v_uint16 unionTypeOffset;
+  };
+private:
+  std::shared_ptr<const CompiledSchema> m_schema;
+  const SchemaObjectInfo* m_object = nullptr;
+  std::vector<FieldPlan> m_inlineFields;
+  std::vector<FieldPlan> m_offsetFields;
+private:
+  ProjectionPlan() = default;
+  ::flatbuffers::uoffset_t copyOffsetField(::flatbuffers::FlatBufferBuilder& builder,
+                                           const ::flatbuffers::Table& table,
+                                           const FieldPlan& plan) const;
+public:
+
+  /**
+   * 编译计划。任一字段名不存在、或字段是 union 向量时返回 nullptr。
+   * @param schema - 已编译 schema。
+   * @param object - 要投影的 table 类型（不能是 struct）。
+   * @param fields - 顶层字段名（去重后的集合）。
+   */
+  static std::shared_ptr<const ProjectionPlan> compile(const std::shared_ptr<const CompiledSchema>& schema,
+                                                       const SchemaObjectInfo* object,
+                                                       const std::vector<std::string>& fields);
+
+  const SchemaObjectInfo* getObject() const;
+
+  /**
+   * 计划是否只含标量 / struct 字段。
+   */
+  bool isInlineOnly() const;
+
+  /**
+   * 把 table 的选中字段写入 builder，返回新 table 的偏移（不调用 Finish）。
+   */
+  ::flatbuffers::Offset<::flatbuffers::Table> encode(::flatbuffers::FlatBufferBuilder& builder,
+                                                     const ::flatbuffers::Table& table) const;
+
+  /**
+   * 投影整个 buffer：编码根 table 并 Finish；源 buffer 带 schema 的 file_identifier 时保留之。
+   * @param builder - 空 builder（建议取自 BuilderPool）。
+   * @param buffer - 已校验、以 `getObject()` 为根的 FlatBuffer。
+   */
+  void apply(::flatbuffers::FlatBufferBuilder& builder, const uint8_t* buffer) const;
+
+};
+
+/**
+ * 字段投影入口：从 `fields=name,hp` 这样的列表生成精简后的 FlatBuffer。
+ * 计划按 (类型, 规范化后的字段集合) 缓存；字段列表来自客户端，缓存条数有上限，
+ * 超出后新计划仍可使用，只是不再缓存。
+ */
+class Projector {
+public:
+  static constexpr v_int32 DEFAULT_MAX_PLANS = 1024;
+private:
+  std::shared_ptr<const CompiledSchema> m_schema;
+  v_int32 m_maxPlans;
+  std::mutex m_mutex;
+  std::unordered_map<std::string, std::shared_ptr<const ProjectionPlan>> m_plans;
+  std::unordered_map<const oatpp::Type*, const SchemaObjectInfo*> m_types;
+private:
+  const SchemaObjectInfo* findBoundObject(const oatpp::Type* type);
+  std::shared_ptr<const ProjectionPlan> projectBuffer(const oatpp::Type* type,
+                                                      const oatpp::String& fields,
+                                                      const AbstractFlatBuffersObject& source,
+                                                      ::flatbuffers::FlatBufferBuilder& builder);
+public:
+
+  Projector(const std::shared_ptr<const CompiledSchema>& schema, v_int32 maxPlans = DEFAULT_MAX_PLANS);
+
+  static std::shared_ptr<Projector> createShared(const std::shared_ptr<const CompiledSchema>& schema,
+                                                 v_int32 maxPlans = DEFAULT_MAX_PLANS);
+
+  /**
+   * 把 `Object<T>` 绑定到 schema 中的 table 名；未绑定的类型使用 schema 的 root_type。
+   */
+  void bindType(const oatpp::Type* type, const std::string& qualifiedName);
+
+  template<typename T>
+  void bindType(const std::string& qualifiedName) {
+    bindType(Object<T>::Class::getType(), qualifiedName);
+  }
+
+  /**
+   * 拆分逗号分隔的字段列表：去空白、去重、排序。
+   */
+  static std::vector<std::string> parseFieldList(const std::string& fields);
+
+  /**
+   * 取（或编译并缓存）计划；字段不存在时返回 nullptr。
+   */
+  std::shared_ptr<const ProjectionPlan> getPlan(const SchemaObjectInfo* object, const std::string& fields);
+
+  /**
+   * 投影 `Object<T>`。`fields` 为空时原样返回；字段不存在或源 buffer 校验失败时返回 nullptr。
+   */
+  template<typename T>
+  Object<T> project(const Object<T>& source, const oatpp::String& fields) {
+    if (!source || !fields || fields->empty()) {
+      return source;
+    }
+    auto builder = BuilderPool::instance().acquire();
+    if (!projectBuffer(Object<T>::Class::getType(), fields, *source.getPtr(), *builder)) {
+      return nullptr;
+    }
+    return Object<T>::fromPooledBuilder(std::move(builder));
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_PROJECTION_HPP */
@@ -0,0 +1,147 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef OATPP_FLATBUFFERS_REQUEST_BODY_READER_HPP
+#define OATPP_FLATBUFFERS_REQUEST_BODY_READER_HPP
+
+#include "AlignedBodyReader.hpp"
+#include "ContentEncoding.hpp"
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/async/Coroutine.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+
+#include <cstdlib>
+#include <memory>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * `request->readBodyToDtoAsync<Object<T>>(mapper)` 的替代：按请求头透明地解码
+ * `Content-Encoding`（gzip / zstd / lz4）后再交给 ObjectMapper，结果作为协程返回值给出，
+ * 端点只需把 `readBodyToDtoAsync` 换成 `RequestBodyReader<T>::startForResult(request, mapper)`。
+ *
+ * - 有 Content-Length 时交给 AlignedBodyReader：body 直接读入对齐的池化缓冲，压缩 body 直接解压到另一个池化缓冲；
+ * - 没有（chunked）时由 oatpp 解开传输编码读成 String，未压缩则借用，压缩则解压到池化缓冲；
+ * - 给出请求 Arena 时，需要拷贝的读取（无法借用的 body）把拷贝与包装对象放在其中；
+ *   Arena 是显式传入的协程成员，读取跨越 yield 也没有问题；
+ * - body 非法、Content-Encoding 不支持、超过 `maxBodySize`（压缩时同时约束解压后大小）或读取出错时
+ *   返回 nullptr，与 `readBodyToDtoAsync` 读到非法 body 时一样由调用方回 400。
+ *
+ * @tparam T - FlatBuffers 生成的 Table 类型
+ */
+template<typename T>
+class RequestBodyReader : public oatpp::async::CoroutineWithResult<RequestBodyReader<T>, const Object<T>&> {
+public:
+  using Action = oatpp::async::Action;
+  using IncomingRequest = oatpp::web::protocol::http::incoming::Request;
+private:
+  std::shared_ptr<IncomingRequest> m_request;
+  std::shared_ptr<ObjectMapper> m_mapper;
+  std::shared_ptr<Arena> m_arena;
+  v_buff_size m_maxBodySize;
+  oatpp::String m_contentEncoding;
+  Object<T> m_result;
+public:
+
+  /**
+   * Constructor.
+   * @param request - 传入的请求。
+   * @param mapper - 用于构造 `Object<T>` 的 ObjectMapper。
+   * @param arena - 请求 Arena，可为 nullptr。
+   * @param maxBodySize - body 上限（压缩时同时约束解压后的大小）。
+   */
+  RequestBodyReader(const std::shared_ptr<IncomingRequest>& request,
+                    const std::shared_ptr<ObjectMapper>& mapper,
+                    const std::shared_ptr<Arena>& arena = nullptr,
+                    v_buff_size maxBodySize = 16 * 1024 * 1024)
+    : m_request(request)
+    , m_mapper(mapper)
+    , m_arena(arena)
+    , m_maxBodySize(maxBodySize)
+  {}
+
+  Action act() override {
+    using Header = oatpp::web::protocol::http::Header;
+    m_contentEncoding = m_request->getHeader(Header::CONTENT_ENCODING);
+    auto contentLength = m_request->getHeader(Header::CONTENT_LENGTH);
+    if (contentLength) {
+      return AlignedBodyReader<T>::start(
+          m_request->getBodyStream(),
+          m_mapper,
+          [this](const Object<T>& object) -> oatpp::async::CoroutineStarter {
+            m_result = object;
+            return nullptr;
+          },
+          std::strtoll(contentLength->c_str(), nullptr, 10),
+          m_maxBodySize,
+          m_contentEncoding,
+          m_arena)
+        .next(this->yieldTo(&RequestBodyReader::onDone));
+    }
+    return m_request->readBodyToStringAsync().callbackTo(&RequestBodyReader::onBodyString);
+  }
+
+  Action onBodyString(const oatpp::String& body) {
+    ContentEncoding::Codec codec;
+    if (!body || static_cast<v_buff_size>(body->size()) > m_maxBodySize ||
+        !ContentEncoding::parse(m_contentEncoding, codec) || !ContentEncoding::isAvailable(codec)) {
+      return this->_return(nullptr);
+    }
+    oatpp::data::mapping::ErrorStack errorStack;
+    oatpp::Void value;
+    if (codec == ContentEncoding::Codec::IDENTITY) {
+      oatpp::utils::parser::Caret caret(body);
+      value = m_mapper->read(caret, Object<T>::Class::getType(), m_arena, errorStack);
+    } else {
+      auto decoded = ContentEncoding::decode(codec, reinterpret_cast<const uint8_t*>(body->data()),
+                                             static_cast<v_buff_size>(body->size()), m_maxBodySize);
+      if (!decoded) {
+        return this->_return(nullptr);
+      }
+      value = m_mapper->readFromBuffer(decoded, Object<T>::Class::getType(), errorStack, m_arena);
+    }
+    if (!errorStack.empty() || !value) {
+      return this->_return(nullptr);
+    }
+    return this->_return(value.template cast<Object<T>>());
+  }
+
+  Action onDone() {
+    return this->_return(m_result);
+  }
+
+  Action handleError(oatpp::async::Error* error) override {
+    (void) error;
+    return this->_return(nullptr);
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_REQUEST_BODY_READER_HPP */
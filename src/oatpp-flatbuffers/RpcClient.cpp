@@ -0,0 +1,95 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RpcClient.hpp"
+
+#include "FlatBuffersBody.hpp"
+#include "FlatBuffersStreamBody.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#include <stdexcept>
+
+namespace oatpp { namespace flatbuffers {
+
+RpcClient::RpcClient(const std::shared_ptr<const RpcServiceInfo>& info,
+                     const std::shared_ptr<oatpp::web::client::RequestExecutor>& executor,
+                     const std::shared_ptr<ObjectMapper>& mapper)
+  : m_info(info)
+  , m_executor(executor)
+  , m_mapper(mapper)
+{}
+
+std::shared_ptr<RpcClient> RpcClient::createShared(const std::shared_ptr<const CompiledSchema>& schema,
+                                                   const std::string& serviceName,
+                                                   const std::shared_ptr<oatpp::web::client::RequestExecutor>& executor,
+                                                   const std::shared_ptr<ObjectMapper>& mapper,
+                                                   const std::string& basePath)
+{
+  auto info = RpcServiceInfo::create(schema, serviceName, basePath);
+  if (!info) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcClient::createShared()]: Unknown rpc_service '" + serviceName + "'");
+  }
+  return std::make_shared<RpcClient>(info, executor, mapper);
+}
+
+const std::shared_ptr<const RpcServiceInfo>& RpcClient::getInfo() const {
+  return m_info;
+}
+
+const std::shared_ptr<ObjectMapper>& RpcClient::getObjectMapper() const {
+  return m_mapper;
+}
+
+const RpcCallInfo& RpcClient::checkCall(const std::string& name, bool streamingRequest) const {
+  auto call = m_info->findCall(name);
+  if (call == nullptr) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcClient::checkCall()]: Unknown rpc call '" + name + "'");
+  }
+  if (call->streaming == RpcStreaming::BIDI) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcClient::checkCall()]: Bidirectional rpc call '" + name + "' needs a streaming transport");
+  }
+  if ((call->streaming == RpcStreaming::CLIENT) != streamingRequest) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcClient::checkCall()]: Streaming mode mismatch for rpc call '" + name + "'");
+  }
+  return *call;
+}
+
+RpcClient::ResponseStarter RpcClient::execute(const RpcCallInfo& call,
+                                              const std::shared_ptr<oatpp::web::protocol::http::outgoing::Body>& body) const
+{
+  oatpp::web::protocol::http::Headers headers;
+  headers.put(oatpp::web::protocol::http::Header::CONTENT_TYPE, "application/x-flatbuffers");
+  return m_executor->executeAsync("POST", call.path.c_str(), headers, body, nullptr);
+}
+
+RpcClient::ResponseStarter RpcClient::call(const std::string& name, const oatpp::Void& request) const {
+  return execute(checkCall(name, false), FlatBuffersBody::createShared(request));
+}
+
+RpcClient::ResponseStarter RpcClient::callStream(const std::string& name, const std::vector<oatpp::Void>& requests) const {
+  return execute(checkCall(name, true), FlatBuffersStreamBody::createShared(requests));
+}
+
+}}
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_RPC_CLIENT_HPP
+#define OATPP_FLATBUFFERS_RPC_CLIENT_HPP
+
+#include "RpcServiceInfo.hpp"
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+#include "FrameSink.hpp"
+
+#include "oatpp/web/client/RequestExecutor.hpp"
+#include "oatpp/web/protocol/http/incoming/Response.hpp"
+#include "oatpp/async/Coroutine.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 由 `.bfbs` 中的 `rpc_service` 生成的异步客户端，与 RpcService 的路由一一对应。
+ * - unary / server streaming：`call()` 发送单个请求对象；
+ * - client streaming：`callStream()` 把对象列表按 size-prefixed 帧原地写出（Content-Length 已知，不拼接）；
+ * - server streaming 的响应用 `readFrames<T>()` 逐帧解码（chunked 由 oatpp 解开）。
+ */
+class RpcClient {
+public:
+  typedef oatpp::web::protocol::http::incoming::Response Response;
+  typedef oatpp::async::CoroutineStarterForResult<const std::shared_ptr<Response>&> ResponseStarter;
+private:
+
+  template<typename T>
+  class ReadFrames : public oatpp::async::Coroutine<ReadFrames<T>> {
+    using Action = oatpp::async::Action;
+  private:
+    std::shared_ptr<Response> m_response;
+    std::shared_ptr<FrameSink<T>> m_sink;
+  public:
+    ReadFrames(const std::shared_ptr<Response>& response, const std::shared_ptr<FrameSink<T>>& sink)
+      : m_response(response), m_sink(sink)
+    {}
+
+    Action act() override {
+      return m_response->transferBodyToStreamAsync(m_sink).next(this->yieldTo(&ReadFrames::onDone));
+    }
+
+    Action onDone() {
+      if (!m_sink->isComplete()) {
+        return this->template error<oatpp::async::Error>("[oatpp::flatbuffers::RpcClient::readFrames()]: Truncated or invalid frame stream");
+      }
+      return this->finish();
+    }
+  };
+
+private:
+  std::shared_ptr<const RpcServiceInfo> m_info;
+  std::shared_ptr<oatpp::web::client::RequestExecutor> m_executor;
+  std::shared_ptr<ObjectMapper> m_mapper;
+private:
+  const RpcCallInfo& checkCall(const std::string& name, bool streamingRequest) const;
+  ResponseStarter execute(const RpcCallInfo& call,
+                          const std::shared_ptr<oatpp::web::protocol::http::outgoing::Body>& body) const;
+public:
+
+  /**
+   * Constructor.
+   * @param info - service 描述。
+   * @param executor - 请求执行器（如 HttpRequestExecutor）。
+   * @param mapper - 解码响应使用的 ObjectMapper。
+   */
+  RpcClient(const std::shared_ptr<const RpcServiceInfo>& info,
+            const std::shared_ptr<oatpp::web::client::RequestExecutor>& executor,
+            const std::shared_ptr<ObjectMapper>& mapper);
+
+  /**
+   * 从 schema 中查找 service 并创建；service 不存在时抛出 std::runtime_error。
+   */
+  static std::shared_ptr<RpcClient> createShared(const std::shared_ptr<const CompiledSchema>& schema,
+                                                 const std::string& serviceName,
+                                                 const std::shared_ptr<oatpp::web::client::RequestExecutor>& executor,
+                                                 const std::shared_ptr<ObjectMapper>& mapper,
+                                                 const std::string& basePath = "");
+
+  const std::shared_ptr<const RpcServiceInfo>& getInfo() const;
+
+  const std::shared_ptr<ObjectMapper>& getObjectMapper() const;
+
+  /**
+   * unary / server streaming 调用。
+   * @param name - 调用名。
+   * @param request - FlatBuffers 请求对象（`Object<T>`）。
+   */
+  ResponseStarter call(const std::string& name, const oatpp::Void& request) const;
+
+  /**
+   * client streaming 调用。
+   * @param name - 调用名。
+   * @param requests - 依次发送的 FlatBuffers 对象。
+   */
+  ResponseStarter callStream(const std::string& name, const std::vector<oatpp::Void>& requests) const;
+
+  /**
+   * 逐帧解码 server streaming 响应；流截断或帧非法时以错误结束。
+   * @param response - `call()` 返回的响应。
+   * @param callback - 每帧回调，返回 false 中止。
+   */
+  template<typename T>
+  oatpp::async::CoroutineStarter readFrames(const std::shared_ptr<Response>& response,
+                                            const typename FrameSink<T>::Callback& callback) const {
+    return ReadFrames<T>::start(response, std::make_shared<FrameSink<T>>(m_mapper, callback));
+  }
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_RPC_CLIENT_HPP */
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RpcService.hpp"
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+class RespondWith : public oatpp::async::CoroutineWithResult<RespondWith, const std::shared_ptr<RpcHandler::OutgoingResponse>&> {
+private:
+  std::shared_ptr<RpcHandler::OutgoingResponse> m_response;
+public:
+  explicit RespondWith(const std::shared_ptr<RpcHandler::OutgoingResponse>& response)
+    : m_response(response)
+  {}
+
+  Action act() override {
+    return _return(m_response);
+  }
+};
+
+}
+
+std::shared_ptr<RpcHandler::OutgoingResponse> RpcHandler::errorResponse(const Status& status, const oatpp::String& message) {
+  return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(status, message);
+}
+
+std::shared_ptr<RpcHandler::OutgoingResponse> RpcHandler::objectResponse(const oatpp::Void& object) {
+  return OutgoingResponse::createShared(Status::CODE_200, FlatBuffersBody::createShared(object));
+}
+
+std::shared_ptr<RpcHandler::OutgoingResponse> RpcUnimplementedHandler::handle(const std::shared_ptr<IncomingRequest>& request) {
+  (void) request;
+  if (m_call.streaming == RpcStreaming::BIDI) {
+    return errorResponse(Status::CODE_501, "Bidirectional streaming is not available over HTTP request/response");
+  }
+  return errorResponse(Status::CODE_501, "Rpc call '" + m_call.name + "' is not implemented");
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<RpcHandler::OutgoingResponse>&>
+RpcUnimplementedHandler::handleAsync(const std::shared_ptr<IncomingRequest>& request) {
+  return RespondWith::startForResult(handle(request));
+}
+
+RpcService::RpcService(const std::shared_ptr<const RpcServiceInfo>& info, const std::shared_ptr<ObjectMapper>& mapper)
+  : m_info(info)
+  , m_mapper(mapper)
+{}
+
+std::shared_ptr<RpcService> RpcService::createShared(const std::shared_ptr<const CompiledSchema>& schema,
+                                                     const std::string& serviceName,
+                                                     const std::shared_ptr<ObjectMapper>& mapper,
+                                                     const std::string& basePath)
+{
+  auto info = RpcServiceInfo::create(schema, serviceName, basePath);
+  if (!info) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcService::createShared()]: Unknown rpc_service '" + serviceName + "'");
+  }
+  return std::make_shared<RpcService>(info, mapper);
+}
+
+const std::shared_ptr<const RpcServiceInfo>& RpcService::getInfo() const {
+  return m_info;
+}
+
+const RpcCallInfo& RpcService::checkCall(const std::string& name, RpcStreaming streaming) const {
+  auto call = m_info->findCall(name);
+  if (call == nullptr) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcService::checkCall()]: Unknown rpc call '" + name + "'");
+  }
+  if (call->streaming != streaming) {
+    throw std::runtime_error("[oatpp::flatbuffers::RpcService::checkCall()]: Streaming mode mismatch for rpc call '" + name + "'");
+  }
+  return *call;
+}
+
+void RpcService::addToRouter(const std::shared_ptr<oatpp::web::server::HttpRouter>& router) const {
+  for (const auto& call : m_info->getCalls()) {
+    auto it = m_handlers.find(call.name);
+    std::shared_ptr<oatpp::web::server::HttpRequestHandler> handler;
+    if (it != m_handlers.end()) {
+      handler = it->second;
+    } else {
+      handler = std::make_shared<RpcUnimplementedHandler>(call, m_mapper);
+    }
+    router->route("POST", call.path.c_str(), handler);
+  }
+}
+
+}}
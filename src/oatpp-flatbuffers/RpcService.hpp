@@ -0,0 +1,381 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_RPC_SERVICE_HPP
+#define OATPP_FLATBUFFERS_RPC_SERVICE_HPP
+
+#include "RpcServiceInfo.hpp"
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+#include "FlatBuffersBody.hpp"
+#include "FlatBuffersStreamBody.hpp"
+#include "FrameReader.hpp"
+#include "FrameSink.hpp"
+#include "RequestBodyReader.hpp"
+
+#include "oatpp/web/server/HttpRequestHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/async/Coroutine.hpp"
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * rpc 调用处理器的公共基类：持有调用描述与 ObjectMapper，统一错误响应。
+ */
+class RpcHandler : public oatpp::web::server::HttpRequestHandler {
+protected:
+  RpcCallInfo m_call;
+  std::shared_ptr<ObjectMapper> m_mapper;
+public:
+  RpcHandler(const RpcCallInfo& call, const std::shared_ptr<ObjectMapper>& mapper)
+    : m_call(call)
+    , m_mapper(mapper)
+  {}
+
+  static std::shared_ptr<OutgoingResponse> errorResponse(const Status& status, const oatpp::String& message);
+
+  static std::shared_ptr<OutgoingResponse> objectResponse(const oatpp::Void& object);
+
+  const RpcCallInfo& getCall() const {
+    return m_call;
+  }
+
+};
+
+/**
+ * 未注册实现的调用（以及走 HTTP 无法表达的 bidi 调用）统一返回 501。
+ */
+class RpcUnimplementedHandler : public RpcHandler {
+public:
+  using RpcHandler::RpcHandler;
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override;
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override;
+
+};
+
+/**
+ * `streaming: "none"`：一个请求对象，一个响应对象。
+ */
+template<typename Req, typename Resp>
+class RpcUnaryHandler : public RpcHandler {
+public:
+  using Handler = std::function<Object<Resp>(const Object<Req>&)>;
+private:
+  class Call : public oatpp::async::CoroutineWithResult<Call, const std::shared_ptr<OutgoingResponse>&> {
+    using Action = oatpp::async::Action;
+  private:
+    std::shared_ptr<IncomingRequest> m_request;
+    std::shared_ptr<ObjectMapper> m_mapper;
+    std::shared_ptr<const Handler> m_handler;
+  public:
+    Call(const std::shared_ptr<IncomingRequest>& request,
+         const std::shared_ptr<ObjectMapper>& mapper,
+         const std::shared_ptr<const Handler>& handler)
+      : m_request(request), m_mapper(mapper), m_handler(handler)
+    {}
+
+    Action act() override {
+      return RequestBodyReader<Req>::startForResult(m_request, m_mapper).callbackTo(&Call::onRequest);
+    }
+
+    Action onRequest(const Object<Req>& request) {
+      if (!request) {
+        return this->_return(errorResponse(Status::CODE_400, "Invalid FlatBuffers request"));
+      }
+      Object<Resp> response;
+      try {
+        response = (*m_handler)(request);
+      } catch (const std::exception& e) {
+        return this->_return(errorResponse(Status::CODE_500, e.what()));
+      }
+      if (!response) {
+        return this->_return(errorResponse(Status::CODE_500, "Empty rpc response"));
+      }
+      return this->_return(objectResponse(response));
+    }
+
+    Action handleError(oatpp::async::Error* error) override {
+      return this->_return(errorResponse(Status::CODE_400, error->what()));
+    }
+  };
+private:
+  std::shared_ptr<const Handler> m_handler;
+public:
+  RpcUnaryHandler(const RpcCallInfo& call, const std::shared_ptr<ObjectMapper>& mapper, const Handler& handler)
+    : RpcHandler(call, mapper)
+    , m_handler(std::make_shared<const Handler>(handler))
+  {}
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+    return Call::startForResult(request, m_mapper, m_handler);
+  }
+
+};
+
+/**
+ * `streaming: "server"`：一个请求对象，响应为 chunked 传输的 size-prefixed 帧序列。
+ * 处理函数返回生成器，响应 body 每次向它拉取一帧，整个回复从不整体缓存。
+ */
+template<typename Req, typename Resp>
+class RpcServerStreamHandler : public RpcHandler {
+public:
+  /**
+   * 返回下一帧；返回 nullptr 结束流。
+   */
+  using Generator = std::function<Object<Resp>()>;
+  using Handler = std::function<Generator(const Object<Req>&)>;
+private:
+  class Call : public oatpp::async::CoroutineWithResult<Call, const std::shared_ptr<OutgoingResponse>&> {
+    using Action = oatpp::async::Action;
+  private:
+    std::shared_ptr<IncomingRequest> m_request;
+    std::shared_ptr<ObjectMapper> m_mapper;
+    std::shared_ptr<const Handler> m_handler;
+  public:
+    Call(const std::shared_ptr<IncomingRequest>& request,
+         const std::shared_ptr<ObjectMapper>& mapper,
+         const std::shared_ptr<const Handler>& handler)
+      : m_request(request), m_mapper(mapper), m_handler(handler)
+    {}
+
+    Action act() override {
+      return RequestBodyReader<Req>::startForResult(m_request, m_mapper).callbackTo(&Call::onRequest);
+    }
+
+    Action onRequest(const Object<Req>& request) {
+      if (!request) {
+        return this->_return(errorResponse(Status::CODE_400, "Invalid FlatBuffers request"));
+      }
+      Generator generator;
+      try {
+        generator = (*m_handler)(request);
+      } catch (const std::exception& e) {
+        return this->_return(errorResponse(Status::CODE_500, e.what()));
+      }
+      if (!generator) {
+        return this->_return(errorResponse(Status::CODE_500, "Empty rpc stream"));
+      }
+      auto body = FlatBuffersStreamBody::createShared([generator]() -> oatpp::Void {
+        return generator();
+      });
+      return this->_return(OutgoingResponse::createShared(Status::CODE_200, body));
+    }
+
+    Action handleError(oatpp::async::Error* error) override {
+      return this->_return(errorResponse(Status::CODE_400, error->what()));
+    }
+  };
+private:
+  std::shared_ptr<const Handler> m_handler;
+public:
+  RpcServerStreamHandler(const RpcCallInfo& call, const std::shared_ptr<ObjectMapper>& mapper, const Handler& handler)
+    : RpcHandler(call, mapper)
+    , m_handler(std::make_shared<const Handler>(handler))
+  {}
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+    return Call::startForResult(request, m_mapper, m_handler);
+  }
+
+};
+
+/**
+ * 客户端流的一次调用状态：逐帧回调，流结束后产出唯一响应。
+ */
+template<typename Req, typename Resp>
+struct RpcClientStream {
+  std::function<void(const Object<Req>&)> onMessage;
+  std::function<Object<Resp>()> onComplete;
+};
+
+/**
+ * `streaming: "client"`：请求 body 为 size-prefixed 帧序列，边读边解码，内存只受最大帧约束。
+ * - 带 Content-Length 的 body 由 FrameReader 直接从 body 流拉取；
+ * - chunked body 先由 oatpp 解码，再写入 FrameSink。
+ */
+template<typename Req, typename Resp>
+class RpcClientStreamHandler : public RpcHandler {
+public:
+  /**
+   * 每次调用创建一份新的流状态。
+   */
+  using Handler = std::function<RpcClientStream<Req, Resp>()>;
+private:
+  class Call : public oatpp::async::CoroutineWithResult<Call, const std::shared_ptr<OutgoingResponse>&> {
+    using Action = oatpp::async::Action;
+  private:
+    std::shared_ptr<IncomingRequest> m_request;
+    std::shared_ptr<ObjectMapper> m_mapper;
+    std::shared_ptr<const Handler> m_handler;
+    RpcClientStream<Req, Resp> m_stream;
+    std::shared_ptr<FrameSink<Req>> m_sink;
+    std::string m_failure;
+  private:
+    bool deliver(const Object<Req>& message) {
+      try {
+        m_stream.onMessage(message);
+        return true;
+      } catch (const std::exception& e) {
+        m_failure = e.what();
+        return false;
+      }
+    }
+  public:
+    Call(const std::shared_ptr<IncomingRequest>& request,
+         const std::shared_ptr<ObjectMapper>& mapper,
+         const std::shared_ptr<const Handler>& handler)
+      : m_request(request), m_mapper(mapper), m_handler(handler)
+    {}
+
+    Action act() override {
+      m_stream = (*m_handler)();
+      auto contentLength = m_request->getHeader(oatpp::web::protocol::http::Header::CONTENT_LENGTH);
+      if (contentLength) {
+        return FrameReader<Req>::start(
+            m_request->getBodyStream(),
+            m_mapper,
+            [this](const Object<Req>& message) -> oatpp::async::CoroutineStarter {
+              if (!deliver(message)) {
+                throw std::runtime_error(m_failure);
+              }
+              return nullptr;
+            },
+            std::strtoll(contentLength->c_str(), nullptr, 10))
+          .next(this->yieldTo(&Call::onComplete));
+      }
+      m_sink = std::make_shared<FrameSink<Req>>(m_mapper, [this](const Object<Req>& message) {
+        return deliver(message);
+      });
+      return m_request->transferBodyToStreamAsync(m_sink).next(this->yieldTo(&Call::onSinkDone));
+    }
+
+    Action onSinkDone() {
+      if (!m_sink->isComplete()) {
+        return this->_return(errorResponse(Status::CODE_400, m_failure.empty() ? "Truncated or invalid frame" : m_failure.c_str()));
+      }
+      return this->yieldTo(&Call::onComplete);
+    }
+
+    Action onComplete() {
+      Object<Resp> response;
+      try {
+        response = m_stream.onComplete();
+      } catch (const std::exception& e) {
+        return this->_return(errorResponse(Status::CODE_500, e.what()));
+      }
+      if (!response) {
+        return this->_return(errorResponse(Status::CODE_500, "Empty rpc response"));
+      }
+      return this->_return(objectResponse(response));
+    }
+
+    Action handleError(oatpp::async::Error* error) override {
+      return this->_return(errorResponse(Status::CODE_400, m_failure.empty() ? error->what() : m_failure.c_str()));
+    }
+  };
+private:
+  std::shared_ptr<const Handler> m_handler;
+public:
+  RpcClientStreamHandler(const RpcCallInfo& call, const std::shared_ptr<ObjectMapper>& mapper, const Handler& handler)
+    : RpcHandler(call, mapper)
+    , m_handler(std::make_shared<const Handler>(handler))
+  {}
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+    return Call::startForResult(request, m_mapper, m_handler);
+  }
+
+};
+
+/**
+ * 由 `.bfbs` 中的 `rpc_service` 生成的异步服务端：按调用名注册实现，
+ * 再把全部调用挂到路由上（`POST <basePath>/<Service>/<Call>`）。
+ * 注册时校验调用存在且 streaming 模式与注册方法一致；未注册的调用返回 501。
+ * `Req` / `Resp` 须与 schema 中该调用的请求 / 响应 table 对应。
+ */
+class RpcService {
+private:
+  std::shared_ptr<const RpcServiceInfo> m_info;
+  std::shared_ptr<ObjectMapper> m_mapper;
+  std::unordered_map<std::string, std::shared_ptr<RpcHandler>> m_handlers;
+private:
+  const RpcCallInfo& checkCall(const std::string& name, RpcStreaming streaming) const;
+public:
+
+  /**
+   * Constructor.
+   * @param info - service 描述。
+   * @param mapper - 请求 / 响应使用的 ObjectMapper（非 sizePrefixed；流式帧的前缀由传输层处理）。
+   */
+  RpcService(const std::shared_ptr<const RpcServiceInfo>& info, const std::shared_ptr<ObjectMapper>& mapper);
+
+  /**
+   * 从 schema 中查找 service 并创建；service 不存在时抛出 std::runtime_error。
+   */
+  static std::shared_ptr<RpcService> createShared(const std::shared_ptr<const CompiledSchema>& schema,
+                                                  const std::string& serviceName,
+                                                  const std::shared_ptr<ObjectMapper>& mapper,
+                                                  const std::string& basePath = "");
+
+  const std::shared_ptr<const RpcServiceInfo>& getInfo() const;
+
+  template<typename Req, typename Resp>
+  void unary(const std::string& name, const typename RpcUnaryHandler<Req, Resp>::Handler& handler) {
+    m_handlers[name] = std::make_shared<RpcUnaryHandler<Req, Resp>>(checkCall(name, RpcStreaming::NONE), m_mapper, handler);
+  }
+
+  template<typename Req, typename Resp>
+  void serverStreaming(const std::string& name, const typename RpcServerStreamHandler<Req, Resp>::Handler& handler) {
+    m_handlers[name] = std::make_shared<RpcServerStreamHandler<Req, Resp>>(checkCall(name, RpcStreaming::SERVER), m_mapper, handler);
+  }
+
+  template<typename Req, typename Resp>
+  void clientStreaming(const std::string& name, const typename RpcClientStreamHandler<Req, Resp>::Handler& handler) {
+    m_handlers[name] = std::make_shared<RpcClientStreamHandler<Req, Resp>>(checkCall(name, RpcStreaming::CLIENT), m_mapper, handler);
+  }
+
+  /**
+   * 把 service 的全部调用注册到路由。
+   */
+  void addToRouter(const std::shared_ptr<oatpp::web::server::HttpRouter>& router) const;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_RPC_SERVICE_HPP */
@@ -0,0 +1,104 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RpcServiceInfo.hpp"
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+const SchemaObjectInfo* findObjectOf(const CompiledSchema& schema, const reflection::Object* object) {
+  return object ? schema.findObject(object->name()->str()) : nullptr;
+}
+
+}
+
+std::shared_ptr<const RpcServiceInfo> RpcServiceInfo::create(const std::shared_ptr<const CompiledSchema>& schema,
+                                                             const std::string& serviceName,
+                                                             const std::string& basePath)
+{
+  if (!schema || !schema->getSchema()->services()) {
+    return nullptr;
+  }
+  const reflection::Service* service = nullptr;
+  for (auto candidate : *schema->getSchema()->services()) {
+    if (candidate->name()->str() == serviceName) {
+      service = candidate;
+      break;
+    }
+  }
+  if (service == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<RpcServiceInfo> info(new RpcServiceInfo());
+  info->m_schema = schema;
+  info->m_name = serviceName;
+  if (auto calls = service->calls()) {
+    for (auto call : *calls) {
+      RpcCallInfo callInfo;
+      callInfo.name = call->name()->str();
+      callInfo.path = basePath + "/" + serviceName + "/" + callInfo.name;
+      callInfo.request = findObjectOf(*schema, call->request());
+      callInfo.response = findObjectOf(*schema, call->response());
+      if (auto attributes = call->attributes()) {
+        auto streaming = attributes->LookupByKey("streaming");
+        if (streaming && streaming->value()) {
+          callInfo.streaming = parseStreaming(streaming->value()->str());
+        }
+        callInfo.idempotent = attributes->LookupByKey("idempotent") != nullptr;
+      }
+      info->m_calls.push_back(std::move(callInfo));
+    }
+  }
+  return info;
+}
+
+RpcStreaming RpcServiceInfo::parseStreaming(const std::string& value) {
+  if (value == "server") return RpcStreaming::SERVER;
+  if (value == "client") return RpcStreaming::CLIENT;
+  if (value == "bidi") return RpcStreaming::BIDI;
+  return RpcStreaming::NONE;
+}
+
+const std::shared_ptr<const CompiledSchema>& RpcServiceInfo::getSchema() const {
+  return m_schema;
+}
+
+const std::string& RpcServiceInfo::getName() const {
+  return m_name;
+}
+
+const std::vector<RpcCallInfo>& RpcServiceInfo::getCalls() const {
+  return m_calls;
+}
+
+const RpcCallInfo* RpcServiceInfo::findCall(const std::string& name) const {
+  for (const auto& call : m_calls) {
+    if (call.name == name) return &call;
+  }
+  return nullptr;
+}
+
+}}
@@ -0,0 +1,103 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_RPC_SERVICE_INFO_HPP
+#define OATPP_FLATBUFFERS_RPC_SERVICE_INFO_HPP
+
+#include "SchemaCache.hpp"
+
+#include "oatpp/Types.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * `rpc_service` 调用的 `streaming` 属性。
+ */
+enum class RpcStreaming : v_int32 {
+  NONE,
+  SERVER,
+  CLIENT,
+  BIDI
+};
+
+/**
+ * 一个 rpc 调用：名字、HTTP 路径与请求 / 响应 table。
+ */
+struct RpcCallInfo {
+  std::string name;
+  // `<basePath>/<Service 全限定名>/<调用名>`
+  std::string path;
+  RpcStreaming streaming = RpcStreaming::NONE;
+  bool idempotent = false;
+  const SchemaObjectInfo* request = nullptr;
+  const SchemaObjectInfo* response = nullptr;
+};
+
+/**
+ * 从 `.bfbs` 反射出的 `rpc_service` 描述，服务端（RpcService）与客户端（RpcClient）共用。
+ */
+class RpcServiceInfo {
+private:
+  std::shared_ptr<const CompiledSchema> m_schema;
+  std::string m_name;
+  std::vector<RpcCallInfo> m_calls;
+private:
+  RpcServiceInfo() = default;
+public:
+
+  /**
+   * 查找并展开 service；schema 中没有该 service 时返回 nullptr。
+   * @param schema - 已编译 schema。
+   * @param serviceName - 全限定名，如 `MyGame.Example.MonsterStorage`。
+   * @param basePath - 路由前缀，如 `/rpc`；默认无前缀。
+   */
+  static std::shared_ptr<const RpcServiceInfo> create(const std::shared_ptr<const CompiledSchema>& schema,
+                                                      const std::string& serviceName,
+                                                      const std::string& basePath = "");
+
+  /**
+   * 解析 `streaming` 属性值；缺省或无法识别时为 NONE。
+   */
+  static RpcStreaming parseStreaming(const std::string& value);
+
+  const std::shared_ptr<const CompiledSchema>& getSchema() const;
+
+  const std::string& getName() const;
+
+  const std::vector<RpcCallInfo>& getCalls() const;
+
+  /**
+   * 按调用名查找；未找到返回 nullptr。
+   */
+  const RpcCallInfo* findCall(const std::string& name) const;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_RPC_SERVICE_INFO_HPP */
@@ -0,0 +1,287 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "SchemaCache.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+void compileField(SchemaFieldInfo& info, const reflection::Field* field) {
+  info.field = field;
+  info.name = field->name()->str();
+  info.offset = field->offset();
+  info.baseType = field->type()->base_type();
+  info.elementType = field->type()->element();
+  info.defaultInteger = field->default_integer();
+  info.defaultReal = field->default_real();
+}
+
+}
+
+const SchemaFieldInfo* SchemaObjectInfo::findField(const std::string& fieldName) const {
+  auto it = fieldsByName.find(fieldName);
+  return it == fieldsByName.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<const CompiledSchema> CompiledSchema::compile(const uint8_t* data, v_buff_size size) {
+  if (data == nullptr || size <= 0) {
+    return nullptr;
+  }
+  std::shared_ptr<CompiledSchema> result(new CompiledSchema());
+  // 自持一份拷贝：reflection 指针全部指向 m_bytes 内部
+  result->m_bytes.assign(reinterpret_cast<const char*>(data), static_cast<size_t>(size));
+  auto bytes = reinterpret_cast<const uint8_t*>(result->m_bytes.data());
+
+  ::flatbuffers::Verifier verifier(bytes, result->m_bytes.size());
+  if (!reflection::VerifySchemaBuffer(verifier)) {
+    return nullptr;
+  }
+  result->m_schema = reflection::GetSchema(bytes);
+
+  auto objects = result->m_schema->objects();
+  result->m_objects.reserve(objects->size());
+  for (auto object : *objects) {
+    auto info = std::unique_ptr<SchemaObjectInfo>(new SchemaObjectInfo());
+    info->object = object;
+    info->name = object->name()->str();
+    info->isStruct = object->is_struct();
+    info->byteSize = object->bytesize();
+    result->m_objectsByName[info->name] = info.get();
+    result->m_objects.push_back(std::move(info));
+  }
+
+  // 第二遍：对象都已建立，才能把 Obj 字段链接到目标对象
+  for (v_uint32 i = 0; i < objects->size(); ++i) {
+    auto& info = *result->m_objects[i];
+    auto fields = objects->Get(i)->fields();
+    info.fields.resize(fields->size());
+    for (v_uint32 j = 0; j < fields->size(); ++j) {
+      auto& fieldInfo = info.fields[j];
+      compileField(fieldInfo, fields->Get(j));
+      auto type = fieldInfo.field->type();
+      bool objectType = fieldInfo.baseType == reflection::Obj ||
+                        (fieldInfo.baseType == reflection::Vector && fieldInfo.elementType == reflection::Obj);
+      if (objectType && type->index() >= 0 && static_cast<v_uint32>(type->index()) < objects->size()) {
+        fieldInfo.object = result->m_objects[type->index()].get();
+      }
+    }
+    // fields 已定长，指针此后不会失效
+    for (auto& fieldInfo : info.fields) {
+      info.fieldsByName[fieldInfo.name] = &fieldInfo;
+    }
+  }
+
+  if (auto rootTable = result->m_schema->root_table()) {
+    result->m_root = result->findObject(rootTable->name()->str());
+  }
+  return result;
+}
+
+const reflection::Schema* CompiledSchema::getSchema() const {
+  return m_schema;
+}
+
+const SchemaObjectInfo* CompiledSchema::getRootObject() const {
+  return m_root;
+}
+
+const SchemaObjectInfo* CompiledSchema::findObject(const std::string& qualifiedName) const {
+  auto it = m_objectsByName.find(qualifiedName);
+  return it == m_objectsByName.end() ? nullptr : it->second;
+}
+
+const SchemaObjectInfo* CompiledSchema::getObject(v_int32 index) const {
+  if (index < 0 || static_cast<size_t>(index) >= m_objects.size()) {
+    return nullptr;
+  }
+  return m_objects[index].get();
+}
+
+FieldPath FieldPath::compile(const std::shared_ptr<const CompiledSchema>& schema,
+                             const SchemaObjectInfo* root,
+                             const std::string& path)
+{
+  FieldPath result;
+  if (!schema) {
+    return result;
+  }
+  const SchemaObjectInfo* current = root ? root : schema->getRootObject();
+  if (!current || current->isStruct || path.empty()) {
+    return result;
+  }
+
+  std::vector<Step> steps;
+  bool inStruct = false;
+  size_t begin = 0;
+  while (true) {
+    size_t end = path.find('.', begin);
+    auto name = path.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    if (current == nullptr) {
+      return FieldPath();
+    }
+    auto field = current->findField(name);
+    if (field == nullptr) {
+      return FieldPath();
+    }
+    if (end == std::string::npos) {
+      result.m_leaf = field;
+      result.m_leafInStruct = inStruct;
+      break;
+    }
+    // 中间段只能是 table 或 struct；vector/union 无法用单一偏移跳转
+    if (field->baseType != reflection::Obj || field->object == nullptr) {
+      return FieldPath();
+    }
+    if (inStruct) {
+      steps.push_back({StepKind::STRUCT_IN_STRUCT, field->offset});
+    } else if (field->object->isStruct) {
+      steps.push_back({StepKind::STRUCT_IN_TABLE, field->offset});
+      inStruct = true;
+    } else {
+      steps.push_back({StepKind::TABLE_IN_TABLE, field->offset});
+    }
+    current = field->object;
+    begin = end + 1;
+  }
+
+  result.m_schema = schema;
+  result.m_steps = std::move(steps);
+  return result;
+}
+
+bool FieldPath::isValid() const {
+  return m_leaf != nullptr;
+}
+
+const SchemaFieldInfo* FieldPath::getLeaf() const {
+  return m_leaf;
+}
+
+const uint8_t* FieldPath::resolve(const uint8_t* buffer) const {
+  if (m_leaf == nullptr || buffer == nullptr) {
+    return nullptr;
+  }
+  auto table = ::flatbuffers::GetAnyRoot(buffer);
+  const uint8_t* structBase = nullptr;
+  for (const auto& step : m_steps) {
+    switch (step.kind) {
+      case StepKind::TABLE_IN_TABLE:
+        table = table->GetPointer<const ::flatbuffers::Table*>(step.offset);
+        if (table == nullptr) return nullptr;
+        break;
+      case StepKind::STRUCT_IN_TABLE:
+        structBase = table->GetStruct<const uint8_t*>(step.offset);
+        if (structBase == nullptr) return nullptr;
+        break;
+      case StepKind::STRUCT_IN_STRUCT:
+        structBase += step.offset;
+        break;
+    }
+  }
+  if (m_leafInStruct) {
+    return structBase + m_leaf->offset;
+  }
+  return table->GetAddressOf(m_leaf->offset);
+}
+
+v_int64 FieldPath::getInteger(const uint8_t* buffer) const {
+  auto address = resolve(buffer);
+  if (address == nullptr) {
+    return m_leaf ? m_leaf->defaultInteger : 0;
+  }
+  return ::flatbuffers::GetAnyValueI(m_leaf->baseType, address);
+}
+
+double FieldPath::getReal(const uint8_t* buffer) const {
+  auto address = resolve(buffer);
+  if (address == nullptr) {
+    if (m_leaf == nullptr) return 0;
+    return ::flatbuffers::IsFloat(m_leaf->baseType) ? m_leaf->defaultReal : static_cast<double>(m_leaf->defaultInteger);
+  }
+  return ::flatbuffers::GetAnyValueF(m_leaf->baseType, address);
+}
+
+const ::flatbuffers::String* FieldPath::getString(const uint8_t* buffer) const {
+  if (m_leaf == nullptr || m_leaf->baseType != reflection::String) {
+    return nullptr;
+  }
+  auto address = resolve(buffer);
+  if (address == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<const ::flatbuffers::String*>(address + ::flatbuffers::ReadScalar<::flatbuffers::uoffset_t>(address));
+}
+
+const ::flatbuffers::Table* FieldPath::getTable(const uint8_t* buffer) const {
+  if (m_leaf == nullptr || m_leaf->baseType != reflection::Obj || m_leaf->object == nullptr || m_leaf->object->isStruct) {
+    return nullptr;
+  }
+  auto address = resolve(buffer);
+  if (address == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<const ::flatbuffers::Table*>(address + ::flatbuffers::ReadScalar<::flatbuffers::uoffset_t>(address));
+}
+
+SchemaCache& SchemaCache::instance() {
+  static SchemaCache cache;
+  return cache;
+}
+
+std::shared_ptr<const CompiledSchema> SchemaCache::load(const std::string& key, const uint8_t* data, v_buff_size size) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_schemas.find(key);
+  if (it != m_schemas.end()) {
+    return it->second;
+  }
+  auto schema = CompiledSchema::compile(data, size);
+  if (schema) {
+    m_schemas[key] = schema;
+  }
+  return schema;
+}
+
+std::shared_ptr<const CompiledSchema> SchemaCache::loadFile(const std::string& path) {
+  if (auto cached = get(path)) {
+    return cached;
+  }
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return load(path, reinterpret_cast<const uint8_t*>(bytes.data()), static_cast<v_buff_size>(bytes.size()));
+}
+
+std::shared_ptr<const CompiledSchema> SchemaCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_schemas.find(key);
+  return it == m_schemas.end() ? nullptr : it->second;
+}
+
+}}
@@ -0,0 +1,214 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_SCHEMA_CACHE_HPP
+#define OATPP_FLATBUFFERS_SCHEMA_CACHE_HPP
+
+#include "oatpp/Types.hpp"
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/reflection.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+struct SchemaObjectInfo;
+
+/**
+ * 预编译的字段描述：把 reflection::Field 的常用属性展开成普通成员，访问时不再走反射表。
+ */
+struct SchemaFieldInfo {
+  const reflection::Field* field = nullptr;
+  std::string name;
+  // table 字段为 vtable 槽位偏移；struct 字段为相对 struct 起点的字节偏移
+  v_uint16 offset = 0;
+  reflection::BaseType baseType = reflection::None;
+  reflection::BaseType elementType = reflection::None;
+  v_int64 defaultInteger = 0;
+  double defaultReal = 0;
+  // baseType 为 Obj，或 Vector 且元素为 Obj 时指向对应对象
+  const SchemaObjectInfo* object = nullptr;
+};
+
+/**
+ * 预编译的 table / struct 描述：字段名到 SchemaFieldInfo 的哈希表。
+ */
+struct SchemaObjectInfo {
+  const reflection::Object* object = nullptr;
+  std::string name;
+  bool isStruct = false;
+  v_int32 byteSize = 0;
+  std::vector<SchemaFieldInfo> fields;
+  std::unordered_map<std::string, const SchemaFieldInfo*> fieldsByName;
+
+  /**
+   * 按名字查找字段；未找到返回 nullptr。
+   */
+  const SchemaFieldInfo* findField(const std::string& fieldName) const;
+};
+
+/**
+ * 一份已校验、已展开的 `.bfbs` 二进制 schema。内容不可变，可被多线程共享。
+ */
+class CompiledSchema {
+private:
+  std::string m_bytes;
+  const reflection::Schema* m_schema = nullptr;
+  std::vector<std::unique_ptr<SchemaObjectInfo>> m_objects;
+  std::unordered_map<std::string, const SchemaObjectInfo*> m_objectsByName;
+  const SchemaObjectInfo* m_root = nullptr;
+private:
+  CompiledSchema() = default;
+public:
+
+  /**
+   * 校验并展开 schema；校验失败返回 nullptr。
+   */
+  static std::shared_ptr<const CompiledSchema> compile(const uint8_t* data, v_buff_size size);
+
+  const reflection::Schema* getSchema() const;
+
+  /**
+   * schema 的 root_type；未声明时返回 nullptr。
+   */
+  const SchemaObjectInfo* getRootObject() const;
+
+  /**
+   * 按全限定名（如 `MyGame.Example.Monster`）查找。
+   */
+  const SchemaObjectInfo* findObject(const std::string& qualifiedName) const;
+
+  /**
+   * 按 reflection::Schema::objects() 中的下标查找。
+   */
+  const SchemaObjectInfo* getObject(v_int32 index) const;
+
+};
+
+/**
+ * 预编译的字段路径句柄（如 `enemy.pos.x`）。编译时完成全部名字查找；
+ * 解析时只按偏移逐层跳转，复杂度 O(深度)，不做字符串比较。
+ */
+class FieldPath {
+private:
+  enum class StepKind : v_int32 {
+    TABLE_IN_TABLE,
+    STRUCT_IN_TABLE,
+    STRUCT_IN_STRUCT
+  };
+  struct Step {
+    StepKind kind;
+    v_uint16 offset;
+  };
+private:
+  std::shared_ptr<const CompiledSchema> m_schema;
+  std::vector<Step> m_steps;
+  const SchemaFieldInfo* m_leaf = nullptr;
+  bool m_leafInStruct = false;
+public:
+  FieldPath() = default;
+
+  /**
+   * 编译路径。任何一段不存在、或中间段不是 table/struct 时返回无效句柄。
+   * @param schema - 已编译 schema（句柄持有其引用）。
+   * @param root - 路径起点对象；传 nullptr 使用 schema 的 root_type。
+   * @param path - 以 '.' 分隔的字段名。
+   */
+  static FieldPath compile(const std::shared_ptr<const CompiledSchema>& schema,
+                           const SchemaObjectInfo* root,
+                           const std::string& path);
+
+  bool isValid() const;
+
+  const SchemaFieldInfo* getLeaf() const;
+
+  /**
+   * 叶子字段在 buffer 中的地址；路径上任一 table 缺失、或叶子字段未写入时返回 nullptr。
+   * @param buffer - 以路径起点对象为根的 FlatBuffer（调用方负责事先校验）。
+   */
+  const uint8_t* resolve(const uint8_t* buffer) const;
+
+  /**
+   * 整数 / 布尔 / 枚举叶子；未写入时返回 schema 默认值。
+   */
+  v_int64 getInteger(const uint8_t* buffer) const;
+
+  /**
+   * 浮点叶子（整数叶子按值转换）；未写入时返回 schema 默认值。
+   */
+  double getReal(const uint8_t* buffer) const;
+
+  /**
+   * 字符串叶子；未写入返回 nullptr。
+   */
+  const ::flatbuffers::String* getString(const uint8_t* buffer) const;
+
+  /**
+   * table 叶子；未写入返回 nullptr。
+   */
+  const ::flatbuffers::Table* getTable(const uint8_t* buffer) const;
+
+};
+
+/**
+ * 进程内 schema 缓存：同一份 `.bfbs` 只校验、展开一次。
+ * 加载在锁内完成，返回的 CompiledSchema 之后可无锁使用。
+ */
+class SchemaCache {
+private:
+  std::mutex m_mutex;
+  std::unordered_map<std::string, std::shared_ptr<const CompiledSchema>> m_schemas;
+private:
+  SchemaCache() = default;
+public:
+  SchemaCache(const SchemaCache&) = delete;
+  SchemaCache& operator=(const SchemaCache&) = delete;
+
+  static SchemaCache& instance();
+
+  /**
+   * 以 `key` 缓存内存中的 schema；已存在时直接返回缓存。校验失败返回 nullptr。
+   */
+  std::shared_ptr<const CompiledSchema> load(const std::string& key, const uint8_t* data, v_buff_size size);
+
+  /**
+   * 读取并缓存 `.bfbs` 文件（以路径为 key）。读取或校验失败返回 nullptr。
+   */
+  std::shared_ptr<const CompiledSchema> loadFile(const std::string& path);
+
+  /**
+   * 已缓存的 schema；没有时返回 nullptr。
+   */
+  std::shared_ptr<const CompiledSchema> get(const std::string& key);
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_SCHEMA_CACHE_HPP */
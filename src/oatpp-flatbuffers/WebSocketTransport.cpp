@@ -0,0 +1,74 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "WebSocketTransport.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace oatpp { namespace flatbuffers {
+
+namespace {
+
+const AbstractFlatBuffersObject* asFlatBuffersObject(const oatpp::Void& object) {
+  const auto* vt = object.getValueType();
+  if (!object || !vt || !vt->extends(AbstractFlatBuffersObject::Class::getType())) {
+    throw std::runtime_error("[oatpp::flatbuffers::WebSocketFrameWriter]: Error. Object is not a FlatBuffers object.");
+  }
+  return static_cast<const AbstractFlatBuffersObject*>(object.get());
+}
+
+}
+
+oatpp::async::CoroutineStarter WebSocketFrameWriter::send(const std::shared_ptr<AsyncWebSocket>& socket, const oatpp::Void& object) {
+  auto raw = asFlatBuffersObject(object);
+  return socket->sendOneFrameBinaryAsync(
+      oatpp::String(reinterpret_cast<const char*>(raw->getBufferData()), raw->getBufferSize()));
+}
+
+oatpp::async::CoroutineStarter WebSocketFrameWriter::sendCoalesced(const std::shared_ptr<AsyncWebSocket>& socket,
+                                                                   const std::vector<oatpp::Void>& objects) {
+  return socket->sendOneFrameBinaryAsync(encodeCoalesced(objects));
+}
+
+oatpp::String WebSocketFrameWriter::encodeCoalesced(const std::vector<oatpp::Void>& objects) {
+  v_buff_size total = 0;
+  for (const auto& object : objects) {
+    total += 4 + asFlatBuffersObject(object)->getBufferSize();
+  }
+  if (total == 0) {
+    return "";
+  }
+  oatpp::String message(total);
+  auto out = reinterpret_cast<uint8_t*>(&message->front());
+  for (const auto& object : objects) {
+    auto raw = asFlatBuffersObject(object);
+    ::flatbuffers::WriteScalar<::flatbuffers::uoffset_t>(out, static_cast<::flatbuffers::uoffset_t>(raw->getBufferSize()));
+    std::memcpy(out + 4, raw->getBufferData(), static_cast<size_t>(raw->getBufferSize()));
+    out += 4 + raw->getBufferSize();
+  }
+  return message;
+}
+
+}}
@@ -0,0 +1,195 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_WEBSOCKET_TRANSPORT_HPP
+#define OATPP_FLATBUFFERS_WEBSOCKET_TRANSPORT_HPP
+
+#include "ObjectMapper.hpp"
+#include "FlatBuffersWrapper.hpp"
+
+#include "oatpp-websocket/AsyncWebSocket.hpp"
+#include "oatpp-websocket/Frame.hpp"
+
+#include "oatpp/utils/parser/Caret.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 基于 oatpp-websocket 的 FlatBuffers 帧传输，用于 HTTP 请求/响应无法表达的双向流（`streaming: "bidi"`）。
+ *
+ * 一条二进制 WebSocket 消息承载：
+ * - mapper 非 sizePrefixed：恰好一个 FlatBuffer；
+ * - mapper 为 sizePrefixed：一个或多个首尾相接的 size-prefixed FlatBuffer（发送端合并小消息）。
+ *
+ * 接收端把消息分片直接追加到一个 oatpp::String，消息结束后 ObjectMapper 以该 String 为锚点
+ * 借用解码：除了从 socket 读入这一次之外不再拷贝，同一消息中的多个对象共享同一锚点。
+ *
+ * @tparam T - FlatBuffers 生成的 Table 类型
+ */
+template<typename T>
+class WebSocketFrameListener : public oatpp::websocket::AsyncWebSocket::Listener {
+public:
+  using AsyncWebSocket = oatpp::websocket::AsyncWebSocket;
+  /**
+   * 每个对象的回调；返回的协程执行完才处理下一个对象。可返回 nullptr。
+   */
+  using Callback = std::function<oatpp::async::CoroutineStarter(const std::shared_ptr<AsyncWebSocket>&, const Object<T>&)>;
+  /**
+   * 1007 - Invalid frame payload data (RFC 6455)。
+   */
+  static constexpr v_uint16 CLOSE_CODE_INVALID_PAYLOAD = 1007;
+  /**
+   * 1009 - Message too big (RFC 6455)。
+   */
+  static constexpr v_uint16 CLOSE_CODE_TOO_BIG = 1009;
+private:
+  std::shared_ptr<ObjectMapper> m_mapper;
+  Callback m_callback;
+  v_buff_size m_maxMessageSize;
+  oatpp::String m_message;
+  bool m_binary = false;
+  bool m_oversized = false;
+  v_int64 m_objectCount = 0;
+private:
+
+  oatpp::async::CoroutineStarter onMessage(const std::shared_ptr<AsyncWebSocket>& socket) {
+    oatpp::String message = std::move(m_message);
+    m_message = nullptr;
+    if (m_oversized) {
+      m_oversized = false;
+      return socket->sendCloseAsync(CLOSE_CODE_TOO_BIG, "FlatBuffers message too big");
+    }
+    if (!m_binary || !message || message->empty()) {
+      return nullptr;
+    }
+    oatpp::utils::parser::Caret caret(message);
+    oatpp::async::CoroutineStarter chain = nullptr;
+    do {
+      oatpp::data::mapping::ErrorStack errorStack;
+      auto value = m_mapper->read(caret, Object<T>::Class::getType(), errorStack);
+      if (!errorStack.empty() || !value) {
+        chain.next(socket->sendCloseAsync(CLOSE_CODE_INVALID_PAYLOAD, "Invalid FlatBuffers frame"));
+        return chain;
+      }
+      ++m_objectCount;
+      chain.next(m_callback(socket, value.template cast<Object<T>>()));
+    } while (m_mapper->getConfig().sizePrefixed && caret.canContinue());
+    return chain;
+  }
+
+public:
+
+  /**
+   * Constructor.
+   * @param mapper - 解码用 ObjectMapper；`sizePrefixed` 决定单帧 / 合并帧格式。
+   * @param callback - 每个对象的回调。
+   * @param maxMessageSize - 单条消息上限，超过即以 1009 关闭连接。
+   */
+  WebSocketFrameListener(const std::shared_ptr<ObjectMapper>& mapper,
+                         const Callback& callback,
+                         v_buff_size maxMessageSize = 16 * 1024 * 1024)
+    : m_mapper(mapper)
+    , m_callback(callback)
+    , m_maxMessageSize(maxMessageSize)
+  {}
+
+  oatpp::async::CoroutineStarter onPing(const std::shared_ptr<AsyncWebSocket>& socket, const oatpp::String& message) override {
+    return socket->sendPongAsync(message);
+  }
+
+  oatpp::async::CoroutineStarter onPong(const std::shared_ptr<AsyncWebSocket>& socket, const oatpp::String& message) override {
+    (void) socket;
+    (void) message;
+    return nullptr;
+  }
+
+  oatpp::async::CoroutineStarter onClose(const std::shared_ptr<AsyncWebSocket>& socket, v_uint16 code, const oatpp::String& message) override {
+    (void) socket;
+    (void) code;
+    (void) message;
+    return nullptr;
+  }
+
+  oatpp::async::CoroutineStarter readMessage(const std::shared_ptr<AsyncWebSocket>& socket, v_uint8 opcode, p_char8 data, oatpp::v_io_size size) override {
+    if (size == 0) {
+      return onMessage(socket);
+    }
+    if (!m_message) {
+      // 续帧的 opcode 为 CONTINUATION，以首帧为准
+      m_binary = opcode == oatpp::websocket::Frame::OPCODE_BINARY;
+      m_message = oatpp::String("");
+    }
+    if (m_oversized || static_cast<v_buff_size>(m_message->size()) + size > m_maxMessageSize) {
+      m_oversized = true;
+      return nullptr;
+    }
+    m_message->append(reinterpret_cast<const char*>(data), static_cast<size_t>(size));
+    return nullptr;
+  }
+
+  /**
+   * 已解码并交给回调的对象数。
+   */
+  v_int64 getObjectCount() const {
+    return m_objectCount;
+  }
+
+};
+
+/**
+ * 发送端：把 FlatBuffers 对象写成二进制 WebSocket 消息。
+ * oatpp-websocket 的发送接口以 oatpp::String 为载荷，因此每条消息拷贝一次；
+ * 合并发送时 N 个对象只拷贝进同一条消息，帧头与系统调用按消息而非按对象计。
+ */
+class WebSocketFrameWriter {
+public:
+  typedef oatpp::websocket::AsyncWebSocket AsyncWebSocket;
+public:
+
+  /**
+   * 一个对象一条消息（对端 mapper 非 sizePrefixed）。
+   * @param object - 类型继承 &id:oatpp::flatbuffers::AbstractFlatBuffersObject; 的对象。
+   */
+  static oatpp::async::CoroutineStarter send(const std::shared_ptr<AsyncWebSocket>& socket, const oatpp::Void& object);
+
+  /**
+   * 多个对象合并为一条消息，逐个加 4 字节前缀（对端 mapper 为 sizePrefixed）。
+   */
+  static oatpp::async::CoroutineStarter sendCoalesced(const std::shared_ptr<AsyncWebSocket>& socket,
+                                                      const std::vector<oatpp::Void>& objects);
+
+  /**
+   * 生成合并消息的载荷（供同步 WebSocket 或自定义发送使用）。
+   */
+  static oatpp::String encodeCoalesced(const std::vector<oatpp::Void>& objects);
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_WEBSOCKET_TRANSPORT_HPP */
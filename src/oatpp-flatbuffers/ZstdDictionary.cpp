@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ZstdDictionary.hpp"
+#include "BufferPool.hpp"
+
+#include "flatbuffers/flatbuffers.h"
+
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
+#include <fstream>
+#include <iterator>
+
+namespace oatpp { namespace flatbuffers {
+
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+
+namespace {
+
+ZSTD_CCtx* threadCCtx() {
+  thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> ctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+  return ctx.get();
+}
+
+}
+
+#endif
+
+ZstdDictionary::ZstdDictionary(const std::string& fileIdentifier, v_uint32 id, v_int32 level, ZSTD_CDict_s* cdict, ZSTD_DDict_s* ddict)
+  : m_fileIdentifier(fileIdentifier)
+  , m_id(id)
+  , m_level(level)
+  , m_cdict(cdict)
+  , m_ddict(ddict)
+{}
+
+ZstdDictionary::~ZstdDictionary() {
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+  ZSTD_freeCDict(m_cdict);
+  ZSTD_freeDDict(m_ddict);
+#endif
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionary::create(const std::string& fileIdentifier, const uint8_t* data, v_buff_size size, v_int32 level) {
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+  if (fileIdentifier.size() != ::flatbuffers::kFileIdentifierLength || !data || size <= 0) {
+    return nullptr;
+  }
+  // 没有 dictID 的原始内容字典无法在解码端按帧头找回，拒绝
+  v_uint32 id = ZSTD_getDictID_fromDict(data, static_cast<size_t>(size));
+  if (id == 0) {
+    return nullptr;
+  }
+  v_int32 effectiveLevel = level > 0 ? level : 3;
+  auto cdict = ZSTD_createCDict(data, static_cast<size_t>(size), effectiveLevel);
+  auto ddict = ZSTD_createDDict(data, static_cast<size_t>(size));
+  if (!cdict || !ddict) {
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+    return nullptr;
+  }
+  return std::make_shared<ZstdDictionary>(fileIdentifier, id, effectiveLevel, cdict, ddict);
+#else
+  (void) fileIdentifier; (void) data; (void) size; (void) level;
+  return nullptr;
+#endif
+}
+
+std::shared_ptr<std::vector<uint8_t>> ZstdDictionary::train(const std::vector<std::vector<uint8_t>>& samples,
+                                                            v_buff_size capacity,
+                                                            std::string* error) {
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+  std::vector<uint8_t> joined;
+  std::vector<size_t> sizes;
+  sizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    joined.insert(joined.end(), sample.begin(), sample.end());
+    sizes.push_back(sample.size());
+  }
+  auto dictionary = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(capacity));
+  size_t n = ZDICT_trainFromBuffer(dictionary->data(), dictionary->size(),
+                                   joined.data(), sizes.data(), static_cast<unsigned>(sizes.size()));
+  if (ZDICT_isError(n)) {
+    if (error) *error = ZDICT_getErrorName(n);
+    return nullptr;
+  }
+  dictionary->resize(n);
+  return dictionary;
+#else
+  (void) samples; (void) capacity;
+  if (error) *error = "zstd is not available in this build";
+  return nullptr;
+#endif
+}
+
+v_uint32 ZstdDictionary::getFrameDictionaryId(const uint8_t* data, v_buff_size size) {
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+  return ZSTD_getDictID_fromFrame(data, static_cast<size_t>(size));
+#else
+  (void) data; (void) size;
+  return 0;
+#endif
+}
+
+std::shared_ptr<std::vector<uint8_t>> ZstdDictionary::compress(const uint8_t* data, v_buff_size size) const {
+#ifdef OATPP_FLATBUFFERS_WITH_ZSTD
+  auto out = BufferPool::instance().acquire(static_cast<v_buff_size>(ZSTD_compressBound(static_cast<size_t>(size))));
+  out->resize(ZSTD_compressBound(static_cast<size_t>(size)));
+  size_t n = ZSTD_compress_usingCDict(threadCCtx(), out->data(), out->size(), data, static_cast<size_t>(size), m_cdict);
+  if (ZSTD_isError(n)) return nullptr;
+  out->resize(n);
+  return out;
+#else
+  (void) data; (void) size;
+  return nullptr;
+#endif
+}
+
+ZstdDictionaryRegistry::ZstdDictionaryRegistry() {
+  m_snapshots.emplace_back(new Snapshot());
+  m_snapshot.store(m_snapshots.back().get(), std::memory_order_release);
+}
+
+ZstdDictionaryRegistry& ZstdDictionaryRegistry::instance() {
+  static ZstdDictionaryRegistry inst;
+  return inst;
+}
+
+v_uint32 ZstdDictionaryRegistry::identifierKey(const char* identifier) {
+  return ::flatbuffers::ReadScalar<v_uint32>(identifier);
+}
+
+bool ZstdDictionaryRegistry::add(const std::shared_ptr<ZstdDictionary>& dictionary) {
+  if (!dictionary) return false;
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  const Snapshot* current = m_snapshot.load(std::memory_order_relaxed);
+  auto existing = current->byId.find(dictionary->getId());
+  if (existing != current->byId.end() && existing->second->getFileIdentifier() != dictionary->getFileIdentifier()) {
+    return false;
+  }
+  std::unique_ptr<Snapshot> next(new Snapshot(*current));
+  next->byIdentifier[identifierKey(dictionary->getFileIdentifier().data())] = dictionary;
+  next->byId[dictionary->getId()] = dictionary;
+  m_snapshot.store(next.get(), std::memory_order_release);
+  m_snapshots.emplace_back(std::move(next));
+  return true;
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::load(const std::string& fileIdentifier, const uint8_t* data, v_buff_size size, v_int32 level) {
+  auto dictionary = ZstdDictionary::create(fileIdentifier, data, size, level);
+  if (!dictionary || !add(dictionary)) {
+    return nullptr;
+  }
+  return dictionary;
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::loadFile(const std::string& fileIdentifier, const std::string& path, v_int32 level) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return nullptr;
+  }
+  std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return load(fileIdentifier, content.data(), static_cast<v_buff_size>(content.size()), level);
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::find(const char* fileIdentifier) const {
+  const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+  auto it = snapshot->byIdentifier.find(identifierKey(fileIdentifier));
+  return it != snapshot->byIdentifier.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::findForBuffer(const uint8_t* buffer, v_buff_size size) const {
+  if (!buffer || size < static_cast<v_buff_size>(sizeof(::flatbuffers::uoffset_t) + ::flatbuffers::kFileIdentifierLength)) {
+    return nullptr;
+  }
+  const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+  if (snapshot->byIdentifier.empty()) {
+    return nullptr;
+  }
+  return find(::flatbuffers::GetBufferIdentifier(buffer));
+}
+
+std::shared_ptr<ZstdDictionary> ZstdDictionaryRegistry::findById(v_uint32 id) const {
+  const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+  auto it = snapshot->byId.find(id);
+  return it != snapshot->byId.end() ? it->second : nullptr;
+}
+
+}}
@@ -0,0 +1,173 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_FLATBUFFERS_ZSTD_DICTIONARY_HPP
+#define OATPP_FLATBUFFERS_ZSTD_DICTIONARY_HPP
+
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace oatpp { namespace flatbuffers {
+
+/**
+ * 针对某一 FlatBuffers 类型训练的 zstd 字典（预先构建好的 CDict / DDict）。
+ *
+ * 几百字节的小消息用通用压缩几乎没有收益：vtable、字段布局与常见字符串在每条消息里重复出现，
+ * 但单条消息内部没有可引用的历史。字典把这些公共部分预先放进窗口，小消息也能明显变小。
+ *
+ * - 字典内容里带有 dictID，压缩帧头部也会写入该 ID，解码端据此在
+ *   &id:oatpp::flatbuffers::ZstdDictionaryRegistry; 中找到对应 DDict；收发双方必须加载同一份字典。
+ * - 需要构建时找到 libzstd（`OATPP_FLATBUFFERS_WITH_ZSTD`），否则 `create()` / `train()` 返回 nullptr。
+ */
+class ZstdDictionary {
+private:
+  std::string m_fileIdentifier;
+  v_uint32 m_id;
+  v_int32 m_level;
+  ZSTD_CDict_s* m_cdict;
+  ZSTD_DDict_s* m_ddict;
+public:
+
+  ZstdDictionary(const std::string& fileIdentifier, v_uint32 id, v_int32 level, ZSTD_CDict_s* cdict, ZSTD_DDict_s* ddict);
+  ZstdDictionary(const ZstdDictionary&) = delete;
+  ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+  ~ZstdDictionary();
+
+  /**
+   * 由字典内容构建 CDict / DDict。
+   * @param fileIdentifier - 该字典服务的类型的 file_identifier（恰好 4 个字符）。
+   * @param data - 字典内容（`train()` 的输出或其保存的文件）。
+   * @param level - 压缩级别，构建 CDict 时固定；0 表示 zstd 默认级别。
+   * @return - 字典；zstd 不可用、内容不是带 ID 的 zstd 字典或参数非法时返回 nullptr。
+   */
+  static std::shared_ptr<ZstdDictionary> create(const std::string& fileIdentifier, const uint8_t* data, v_buff_size size, v_int32 level = 0);
+
+  /**
+   * 从样本训练字典（ZDICT_trainFromBuffer）。样本建议是同一类型的若干百条真实 buffer。
+   * @param samples - 样本 buffer。
+   * @param capacity - 字典最大字节数，通常为样本总量的 1/100 左右，几 KB 即可。
+   * @param error - 失败时写入原因（可为 nullptr）。
+   * @return - 字典内容；失败返回 nullptr。
+   */
+  static std::shared_ptr<std::vector<uint8_t>> train(const std::vector<std::vector<uint8_t>>& samples,
+                                                     v_buff_size capacity,
+                                                     std::string* error = nullptr);
+
+  /**
+   * 读取 zstd 帧头中的 dictID；未使用字典或不是 zstd 帧时返回 0。
+   */
+  static v_uint32 getFrameDictionaryId(const uint8_t* data, v_buff_size size);
+
+  const std::string& getFileIdentifier() const {
+    return m_fileIdentifier;
+  }
+
+  v_uint32 getId() const {
+    return m_id;
+  }
+
+  v_int32 getLevel() const {
+    return m_level;
+  }
+
+  const ZSTD_DDict_s* getDDict() const {
+    return m_ddict;
+  }
+
+  /**
+   * 用该字典压缩 [data, data + size)（帧头写入内容长度与 dictID）。
+   * @return - 池化缓冲；失败返回 nullptr。
+   */
+  std::shared_ptr<std::vector<uint8_t>> compress(const uint8_t* data, v_buff_size size) const;
+
+};
+
+/**
+ * 按 file_identifier（压缩时）与 dictID（解压时）索引已加载的字典。
+ * 查找无锁（与 FlatBuffersTypeRegistry 相同的快照发布方式），加载通常只在启动时发生。
+ */
+class ZstdDictionaryRegistry {
+private:
+  struct Snapshot {
+    std::unordered_map<v_uint32, std::shared_ptr<ZstdDictionary>> byIdentifier;
+    std::unordered_map<v_uint32, std::shared_ptr<ZstdDictionary>> byId;
+  };
+private:
+  std::mutex m_writeMutex;
+  std::atomic<const Snapshot*> m_snapshot;
+  std::vector<std::unique_ptr<const Snapshot>> m_snapshots;
+private:
+  ZstdDictionaryRegistry();
+  static v_uint32 identifierKey(const char* identifier);
+public:
+  ZstdDictionaryRegistry(const ZstdDictionaryRegistry&) = delete;
+  ZstdDictionaryRegistry& operator=(const ZstdDictionaryRegistry&) = delete;
+
+  static ZstdDictionaryRegistry& instance();
+
+  /**
+   * 登记字典；同一 file_identifier 的旧字典被替换（旧 dictID 仍可解码）。
+   * dictID 已被其它类型的字典占用时返回 false。
+   */
+  bool add(const std::shared_ptr<ZstdDictionary>& dictionary);
+
+  /**
+   * 构建并登记字典，见 &l:ZstdDictionary::create ();。
+   */
+  std::shared_ptr<ZstdDictionary> load(const std::string& fileIdentifier, const uint8_t* data, v_buff_size size, v_int32 level = 0);
+
+  /**
+   * 从文件（如字典训练工具的输出）加载并登记字典。
+   */
+  std::shared_ptr<ZstdDictionary> loadFile(const std::string& fileIdentifier, const std::string& path, v_int32 level = 0);
+
+  /**
+   * 按 file_identifier 查找；未登记返回 nullptr。
+   */
+  std::shared_ptr<ZstdDictionary> find(const char* fileIdentifier) const;
+
+  /**
+   * 按 buffer 第 4..8 字节的 file_identifier 查找（buffer 不足 8 字节时返回 nullptr）。
+   */
+  std::shared_ptr<ZstdDictionary> findForBuffer(const uint8_t* buffer, v_buff_size size) const;
+
+  /**
+   * 按 dictID 查找；未登记返回 nullptr。
+   */
+  std::shared_ptr<ZstdDictionary> findById(v_uint32 id) const;
+
+};
+
+}}
+
+#endif /* OATPP_FLATBUFFERS_ZSTD_DICTIONARY_HPP */
@@ -0,0 +1,83 @@
+#include "oatpp-flatbuffers/ContentEncoding.hpp"
+#include "oatpp/Types.hpp"
+#include "monster_test_generated.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ofb = oatpp::flatbuffers;
+
+// testarrayofstring / vector_of_doubles 占主体的 Monster：字符串有重复、数值分布窄，贴近真实负载
+static std::vector<uint8_t> buildMonster(int items) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  std::vector<flatbuffers::Offset<flatbuffers::String>> strings;
+  std::vector<double> doubles;
+  for (int i = 0; i < items; ++i) {
+    strings.push_back(builder.CreateString("monster-" + std::to_string(i % 64) + "-inventory-slot"));
+    doubles.push_back(static_cast<double>(i % 100) * 0.25);
+  }
+  auto name = builder.CreateString("MyMonster");
+  auto arrayOfString = builder.CreateVector(strings);
+  auto vectorOfDoubles = builder.CreateVector(doubles);
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(80);
+  mb.add_testarrayofstring(arrayOfString);
+  mb.add_vector_of_doubles(vectorOfDoubles);
+  builder.Finish(mb.Finish());
+  return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+template<typename F>
+static double run(v_int64 iterations, F&& op) {
+  auto start = std::chrono::steady_clock::now();
+  for (v_int64 n = 0; n < iterations; ++n) {
+    if (!op()) {
+      std::cerr << "operation failed" << std::endl;
+      std::exit(1);
+    }
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+}
+
+int main(int argc, char* argv[]) {
+  v_int64 iterations = argc > 1 ? std::atoll(argv[1]) : 2000;
+  using Codec = ofb::ContentEncoding::Codec;
+
+  std::cout << "codec, level, raw bytes, encoded bytes, ratio, encode MB/s, decode MB/s, encode us, decode us" << std::endl;
+  for (int items : {16, 256, 4096}) {
+    auto raw = buildMonster(items);
+    auto rawSize = static_cast<v_buff_size>(raw.size());
+    for (auto codec : {Codec::GZIP, Codec::ZSTD, Codec::LZ4}) {
+      if (!ofb::ContentEncoding::isAvailable(codec)) {
+        std::cout << ofb::ContentEncoding::getName(codec) << ", -, " << rawSize << ", unavailable" << std::endl;
+        continue;
+      }
+      // 0 为默认级别；另测一个偏压缩率的级别，对比 CPU 与字节的取舍
+      for (v_int32 level : {0, 9}) {
+        auto encoded = ofb::ContentEncoding::encode(codec, raw.data(), rawSize, level);
+        if (!encoded) {
+          std::cerr << "encode failed" << std::endl;
+          return 1;
+        }
+        auto encodedSize = static_cast<v_buff_size>(encoded->size());
+        double encodeSeconds = run(iterations, [&]() {
+          return ofb::ContentEncoding::encode(codec, raw.data(), rawSize, level) != nullptr;
+        });
+        double decodeSeconds = run(iterations, [&]() {
+          return ofb::ContentEncoding::decode(codec, encoded->data(), encodedSize, rawSize) != nullptr;
+        });
+        double mb = static_cast<double>(rawSize) / (1024.0 * 1024.0);
+        std::cout << ofb::ContentEncoding::getName(codec) << ", " << (level == 0 ? std::string("default") : std::to_string(level))
+                  << ", " << rawSize << ", " << encodedSize
+                  << ", " << static_cast<double>(rawSize) / static_cast<double>(encodedSize)
+                  << ", " << mb / encodeSeconds << ", " << mb / decodeSeconds
+                  << ", " << encodeSeconds * 1e6 << ", " << decodeSeconds * 1e6 << std::endl;
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include "oatpp-flatbuffers/JsonTranscodingMapper.hpp"
+#include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/Types.hpp"
+#include "monster_test_generated.h"
+#include "monster_test_bfbs_generated.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace ofb = oatpp::flatbuffers;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class TestDto : public oatpp::DTO {
+  DTO_INIT(TestDto, DTO)
+  DTO_FIELD(Int16, a);
+  DTO_FIELD(Int8, b);
+};
+
+class Vec3Dto : public oatpp::DTO {
+  DTO_INIT(Vec3Dto, DTO)
+  DTO_FIELD(Float32, x);
+  DTO_FIELD(Float32, y);
+  DTO_FIELD(Float32, z);
+  DTO_FIELD(Float64, test1);
+  DTO_FIELD(String, test2);
+  DTO_FIELD(Object<TestDto>, test3);
+};
+
+// 与 JSON 样本字段一一对应的 DTO，作为 oatpp::json::ObjectMapper 的对照组
+class MonsterDto : public oatpp::DTO {
+  DTO_INIT(MonsterDto, DTO)
+  DTO_FIELD(Object<Vec3Dto>, pos);
+  DTO_FIELD(Int16, mana);
+  DTO_FIELD(Int16, hp);
+  DTO_FIELD(String, name);
+  DTO_FIELD(List<UInt8>, inventory);
+  DTO_FIELD(String, color);
+  DTO_FIELD(List<Int64>, vector_of_longs);
+  DTO_FIELD(List<Float64>, vector_of_doubles);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+static const char* SAMPLE_JSON =
+  "{\"pos\":{\"x\":1.0,\"y\":2.0,\"z\":3.0,\"test1\":3.0,\"test2\":\"Green\",\"test3\":{\"a\":5,\"b\":6}},"
+  "\"mana\":150,\"hp\":80,\"name\":\"MyMonster\",\"inventory\":[0,1,2,3,4,5,6,7,8,9],\"color\":\"Green\","
+  "\"vector_of_longs\":[1,100,10000,1000000,100000000],"
+  "\"vector_of_doubles\":[-1.5,0.0,1.5]}";
+
+template<typename F>
+static double run(v_int64 iterations, F&& op) {
+  auto start = std::chrono::steady_clock::now();
+  for (v_int64 n = 0; n < iterations; ++n) {
+    if (!op()) {
+      std::cerr << "operation failed" << std::endl;
+      std::exit(1);
+    }
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(iterations) / elapsed;
+}
+
+int main(int argc, char* argv[]) {
+  v_int64 iterations = argc > 1 ? std::atoll(argv[1]) : 200000;
+
+  auto transcoder = ofb::JsonTranscodingMapper::createShared(
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  transcoder->bindRootType<MyGame::Example::Monster>("MyGame.Example.Monster");
+  oatpp::json::ObjectMapper jsonMapper;
+
+  oatpp::String json(SAMPLE_JSON);
+  auto monster = transcoder->readFromString<ofb::Object<MyGame::Example::Monster>>(json);
+  auto dto = jsonMapper.readFromString<oatpp::Object<MonsterDto>>(json);
+  if (!monster || monster->hp() != 80 || !dto || *dto->hp != 80) {
+    std::cerr << "failed to parse sample" << std::endl;
+    return 1;
+  }
+
+  double dtoRead = run(iterations, [&]() {
+    return jsonMapper.readFromString<oatpp::Object<MonsterDto>>(json) != nullptr;
+  });
+  double fbRead = run(iterations, [&]() {
+    return transcoder->readFromString<ofb::Object<MyGame::Example::Monster>>(json) != nullptr;
+  });
+  double dtoWrite = run(iterations, [&]() {
+    return jsonMapper.writeToString(dto) != nullptr;
+  });
+  double fbWrite = run(iterations, [&]() {
+    return transcoder->writeToString(monster) != nullptr;
+  });
+
+  std::cout << "direction, oatpp::json DTO ops/s, flatbuffers transcoder ops/s, ratio" << std::endl;
+  std::cout << "json -> object, " << static_cast<v_int64>(dtoRead) << ", "
+            << static_cast<v_int64>(fbRead) << ", " << fbRead / dtoRead << std::endl;
+  std::cout << "object -> json, " << static_cast<v_int64>(dtoWrite) << ", "
+            << static_cast<v_int64>(fbWrite) << ", " << fbWrite / dtoWrite << std::endl;
+  return 0;
+}
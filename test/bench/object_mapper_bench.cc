@@ -0,0 +1,236 @@
+#include "oatpp-flatbuffers/ObjectMapper.hpp"
+#include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+#include "oatpp/Types.hpp"
+#include "monster_test_generated.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace ofb = oatpp::flatbuffers;
+
+// 全局 operator new 计数：每个基准报告 allocs/op，读写路径上的改动能直接看出多/少了几次分配。
+// 按线程计数：ThreadRange 的各线程只统计自己的分配，框架把各线程的计数与迭代数分别求和后再相除
+static thread_local v_int64 t_allocations = 0;
+
+static void* countedAlloc(std::size_t size) {
+  ++t_allocations;
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+static void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+  ++t_allocations;
+  auto alignment = static_cast<std::size_t>(align);
+#ifdef _MSC_VER
+  if (void* p = _aligned_malloc(size ? size : 1, alignment)) return p;
+#else
+  void* p = nullptr;
+  if (posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size ? size : 1) == 0) return p;
+#endif
+  throw std::bad_alloc();
+}
+
+static void alignedFree(void* p) noexcept {
+#ifdef _MSC_VER
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void* operator new(std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+class AllocationCounter {
+private:
+  v_int64 m_start;
+public:
+  AllocationCounter() : m_start(t_allocations) {}
+  void report(benchmark::State& state, v_int64 bytesPerOp) const {
+    state.counters["allocs/op"] = benchmark::Counter(
+        static_cast<double>(t_allocations - m_start),
+        benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * bytesPerOp);
+  }
+};
+
+// inventory 长度决定 buffer 大小，其余字段固定
+static const std::vector<uint8_t>& monsterBytes(v_int64 inventorySize) {
+  thread_local std::vector<uint8_t> cached;
+  thread_local v_int64 cachedSize = -1;
+  if (cachedSize != inventorySize) {
+    flatbuffers::FlatBufferBuilder builder(static_cast<size_t>(inventorySize + 256));
+    std::vector<uint8_t> inventory(static_cast<size_t>(inventorySize));
+    for (size_t i = 0; i < inventory.size(); ++i) inventory[i] = static_cast<uint8_t>(i);
+    auto name = builder.CreateString("MyMonster");
+    auto inventoryOffset = builder.CreateVector(inventory);
+    auto pos = MyGame::Example::Vec3(1.0f, 2.0f, 3.0f, 3.0, MyGame::Example::Color_Green, MyGame::Example::Test(5, 6));
+    MyGame::Example::MonsterBuilder mb(builder);
+    mb.add_pos(&pos);
+    mb.add_name(name);
+    mb.add_hp(80);
+    mb.add_inventory(inventoryOffset);
+    MyGame::Example::FinishMonsterBuffer(builder, mb.Finish());
+    cached.assign(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+    cachedSize = inventorySize;
+  }
+  return cached;
+}
+
+static const oatpp::Type* monsterType() {
+  return ofb::Object<MyGame::Example::Monster>::Class::getType();
+}
+
+static void BM_ReadBorrow(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  oatpp::String body(reinterpret_cast<const char*>(raw.data()), static_cast<v_buff_size>(raw.size()));
+  ofb::ObjectMapper mapper;
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    oatpp::utils::parser::Caret caret(body);
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = mapper.read(caret, monsterType(), errorStack);
+    benchmark::DoNotOptimize(value);
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_ReadBorrow)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_ReadCopy(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  ofb::ObjectMapper mapper;
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    // 没有内存句柄的 Caret：read() 必须拷贝（池化缓冲或尾随存储）
+    oatpp::utils::parser::Caret caret(reinterpret_cast<const char*>(raw.data()), static_cast<v_buff_size>(raw.size()));
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = mapper.read(caret, monsterType(), errorStack);
+    benchmark::DoNotOptimize(value);
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_ReadCopy)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_ReadBorrowLazyVerify(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  oatpp::String body(reinterpret_cast<const char*>(raw.data()), static_cast<v_buff_size>(raw.size()));
+  ofb::ObjectMapper::Config config;
+  config.lazyVerify = true;
+  ofb::ObjectMapper mapper(config);
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    oatpp::utils::parser::Caret caret(body);
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = mapper.read(caret, monsterType(), errorStack);
+    benchmark::DoNotOptimize(value);
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_ReadBorrowLazyVerify)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_Verify(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  auto verify = ofb::FlatBuffersTypeRegistry::instance().findVerify(monsterType());
+  ofb::FlatBuffersVerifyOptions options;
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    bool ok = verify(raw.data(), static_cast<v_buff_size>(raw.size()), options, false);
+    benchmark::DoNotOptimize(ok);
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_Verify)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_Write(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw.data(), static_cast<v_buff_size>(raw.size()));
+  ofb::ObjectMapper mapper;
+  oatpp::data::stream::BufferOutputStream stream(static_cast<v_buff_size>(raw.size()) + 64);
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    stream.setCurrentPosition(0);
+    oatpp::data::mapping::ErrorStack errorStack;
+    mapper.write(&stream, monster, errorStack);
+    benchmark::DoNotOptimize(stream.getData());
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_Write)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_WriteToString(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw.data(), static_cast<v_buff_size>(raw.size()));
+  ofb::ObjectMapper mapper;
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    auto written = mapper.writeToString(monster);
+    benchmark::DoNotOptimize(written);
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_WriteToString)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_RegistryFindFactory(benchmark::State& state) {
+  auto& registry = ofb::FlatBuffersTypeRegistry::instance();
+  auto type = monsterType();
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    auto factory = registry.findFactory(type);
+    benchmark::DoNotOptimize(factory);
+  }
+  allocations.report(state, 0);
+}
+BENCHMARK(BM_RegistryFindFactory)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ObjectFromBytes(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw.data(), static_cast<v_buff_size>(raw.size()));
+    benchmark::DoNotOptimize(monster);
+  }
+  allocations.report(state, static_cast<v_int64>(raw.size()));
+}
+BENCHMARK(BM_ObjectFromBytes)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void BM_ObjectFromBuffer(benchmark::State& state) {
+  const auto& raw = monsterBytes(state.range(0));
+  auto buffer = std::make_shared<const std::vector<uint8_t>>(raw);
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    auto monster = ofb::Object<MyGame::Example::Monster>::fromBuffer(buffer);
+    benchmark::DoNotOptimize(monster);
+  }
+  allocations.report(state, 0);
+}
+BENCHMARK(BM_ObjectFromBuffer)->Arg(16)->Arg(1 << 20);
+
+static void BM_ObjectCopy(benchmark::State& state) {
+  const auto& raw = monsterBytes(16);
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw.data(), static_cast<v_buff_size>(raw.size()));
+  AllocationCounter allocations;
+  for (auto _ : state) {
+    ofb::Object<MyGame::Example::Monster> copy = monster;
+    benchmark::DoNotOptimize(copy);
+  }
+  allocations.report(state, 0);
+}
+BENCHMARK(BM_ObjectCopy)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp/Types.hpp"
+#include "monster_test_generated.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ofb = oatpp::flatbuffers;
+
+// 旧实现的等价物：互斥锁 + unordered_map + 按值返回 std::function，作为对照组
+class MutexRegistry {
+public:
+  using Factory = std::function<oatpp::Void(const ofb::FlatBuffersBufferSource&)>;
+private:
+  std::mutex m_mutex;
+  std::unordered_map<const oatpp::data::type::Type*, Factory> m_factories;
+public:
+  void registerFactory(const oatpp::data::type::Type* type, Factory factory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_factories[type] = std::move(factory);
+  }
+  Factory findFactory(const oatpp::data::type::Type* type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_factories.find(type);
+    if (it != m_factories.end()) return it->second;
+    return nullptr;
+  }
+};
+
+template<typename Lookup>
+static double run(v_int32 threads, v_int64 iterations, Lookup&& lookup) {
+  std::atomic<bool> go(false);
+  std::atomic<v_int64> found(0);
+  std::vector<std::thread> workers;
+  for (v_int32 i = 0; i < threads; ++i) {
+    workers.emplace_back([&]() {
+      while (!go.load(std::memory_order_acquire)) {}
+      v_int64 local = 0;
+      for (v_int64 n = 0; n < iterations; ++n) {
+        if (lookup()) ++local;
+      }
+      found.fetch_add(local);
+    });
+  }
+  auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& w : workers) w.join();
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (found.load() != threads * iterations) {
+    std::cerr << "lookup failed" << std::endl;
+    std::exit(1);
+  }
+  return static_cast<double>(threads * iterations) / elapsed;
+}
+
+int main(int argc, char* argv[]) {
+  v_int64 iterations = argc > 1 ? std::atoll(argv[1]) : 2000000;
+  v_int32 maxThreads = static_cast<v_int32>(std::thread::hardware_concurrency());
+  if (maxThreads <= 0) maxThreads = 1;
+
+  const auto* type = ofb::Object<MyGame::Example::Monster>::Class::getType();
+  auto& registry = ofb::FlatBuffersTypeRegistry::instance();
+
+  MutexRegistry baseline;
+  baseline.registerFactory(type, registry.findFactory(type));
+
+  std::cout << "threads, mutex lookups/s, lock-free lookups/s, speedup" << std::endl;
+  std::vector<v_int32> threadCounts;
+  for (v_int32 threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+  threadCounts.push_back(maxThreads);
+
+  for (v_int32 threads : threadCounts) {
+    double mutexRate = run(threads, iterations, [&]() { return static_cast<bool>(baseline.findFactory(type)); });
+    double lockFreeRate = run(threads, iterations, [&]() { return registry.findFactory(type) != nullptr; });
+    std::cout << threads << ", " << static_cast<v_int64>(mutexRate) << ", "
+              << static_cast<v_int64>(lockFreeRate) << ", " << lockFreeRate / mutexRate << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,222 @@
+#include "oatpp-flatbuffers/ObjectMapper.hpp"
+#include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp-flatbuffers/WebSocketTransport.hpp"
+#include "oatpp-websocket/AsyncConnectionHandler.hpp"
+#include "oatpp-websocket/Connector.hpp"
+#include "oatpp-websocket/Handshaker.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/mime/ContentMappers.hpp"
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/Types.hpp"
+#include "monster_test_generated.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ofb = oatpp::flatbuffers;
+
+// 本地回环：客户端经 TCP localhost 发送 Monster，服务端 WebSocketFrameListener 解码计数
+static std::atomic<v_int64> g_received(0);
+
+static std::shared_ptr<ofb::ObjectMapper> createMapper(bool sizePrefixed) {
+  ofb::ObjectMapper::Config config;
+  config.sizePrefixed = sizePrefixed;
+  return std::make_shared<ofb::ObjectMapper>(config);
+}
+
+static ofb::Object<MyGame::Example::Monster> createMonster() {
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto name = builder.CreateString("WS");
+  MyGame::Example::Vec3 pos(1.0f, 2.0f, 3.0f, 4.0, MyGame::Example::Color_Green, MyGame::Example::Test(5, 6));
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(80);
+  mb.add_pos(&pos);
+  builder.Finish(mb.Finish());
+  return ofb::Object<MyGame::Example::Monster>::fromBuilder(std::move(builder));
+}
+
+class CountingSocketListener : public oatpp::websocket::AsyncConnectionHandler::SocketInstanceListener {
+private:
+  std::shared_ptr<ofb::ObjectMapper> m_mapper;
+public:
+  explicit CountingSocketListener(const std::shared_ptr<ofb::ObjectMapper>& mapper)
+    : m_mapper(mapper)
+  {}
+
+  void onAfterCreate_NonBlocking(const std::shared_ptr<AsyncWebSocket>& socket,
+                                 const std::shared_ptr<const oatpp::network::ConnectionHandler::ParameterMap>& params) override {
+    (void) params;
+    socket->setListener(std::make_shared<ofb::WebSocketFrameListener<MyGame::Example::Monster>>(
+        m_mapper,
+        [](const std::shared_ptr<AsyncWebSocket>&, const ofb::Object<MyGame::Example::Monster>& monster)
+            -> oatpp::async::CoroutineStarter {
+          if (monster->hp() == 80) g_received.fetch_add(1, std::memory_order_relaxed);
+          return nullptr;
+        }));
+  }
+
+  void onBeforeDestroy_NonBlocking(const std::shared_ptr<AsyncWebSocket>& socket) override {
+    socket->setListener(nullptr);
+  }
+};
+
+class WebSocketController : public oatpp::web::server::api::ApiController {
+private:
+  std::shared_ptr<oatpp::network::ConnectionHandler> m_single;
+  std::shared_ptr<oatpp::network::ConnectionHandler> m_coalesced;
+public:
+  WebSocketController(const std::shared_ptr<oatpp::web::mime::ContentMappers>& contentMappers,
+                      const std::shared_ptr<oatpp::network::ConnectionHandler>& single,
+                      const std::shared_ptr<oatpp::network::ConnectionHandler>& coalesced)
+    : oatpp::web::server::api::ApiController(contentMappers)
+    , m_single(single)
+    , m_coalesced(coalesced)
+  {}
+
+  const std::shared_ptr<oatpp::network::ConnectionHandler>& getSingle() const { return m_single; }
+  const std::shared_ptr<oatpp::network::ConnectionHandler>& getCoalesced() const { return m_coalesced; }
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+  ENDPOINT_ASYNC("GET", "ws/single", Single) {
+    ENDPOINT_ASYNC_INIT(Single)
+    Action act() override {
+      return _return(oatpp::websocket::Handshaker::serversideHandshake(request->getHeaders(), controller->getSingle()));
+    }
+  };
+
+  ENDPOINT_ASYNC("GET", "ws/coalesced", Coalesced) {
+    ENDPOINT_ASYNC_INIT(Coalesced)
+    Action act() override {
+      return _return(oatpp::websocket::Handshaker::serversideHandshake(request->getHeaders(), controller->getCoalesced()));
+    }
+  };
+
+#include OATPP_CODEGEN_END(ApiController)
+};
+
+class SendCoroutine : public oatpp::async::Coroutine<SendCoroutine> {
+private:
+  std::shared_ptr<oatpp::websocket::Connector> m_connector;
+  oatpp::String m_path;
+  v_int64 m_messages;
+  ofb::Object<MyGame::Example::Monster> m_monster;
+  oatpp::String m_coalesced;
+  std::shared_ptr<oatpp::websocket::AsyncWebSocket> m_socket;
+  v_int64 m_sent = 0;
+public:
+  SendCoroutine(const std::shared_ptr<oatpp::websocket::Connector>& connector,
+                const oatpp::String& path,
+                v_int64 messages,
+                v_int32 batch)
+    : m_connector(connector)
+    , m_path(path)
+    , m_messages(messages)
+    , m_monster(createMonster())
+  {
+    if (batch > 1) {
+      m_coalesced = ofb::WebSocketFrameWriter::encodeCoalesced(std::vector<oatpp::Void>(batch, m_monster));
+    }
+  }
+
+  Action act() override {
+    return m_connector->connectAsync(m_path).callbackTo(&SendCoroutine::onConnected);
+  }
+
+  Action onConnected(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+    m_socket = oatpp::websocket::AsyncWebSocket::createShared(connection, true /* maskOutgoingMessages */);
+    return yieldTo(&SendCoroutine::sendNext);
+  }
+
+  Action sendNext() {
+    if (m_sent == m_messages) {
+      return m_socket->sendCloseAsync().next(finish());
+    }
+    ++m_sent;
+    if (m_coalesced) {
+      return m_socket->sendOneFrameBinaryAsync(m_coalesced).next(repeat());
+    }
+    return ofb::WebSocketFrameWriter::send(m_socket, m_monster).next(repeat());
+  }
+
+  Action handleError(oatpp::async::Error* error) override {
+    std::cerr << "client error: " << error->what() << std::endl;
+    return error;
+  }
+};
+
+static bool waitFor(v_int64 expected) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  while (g_received.load(std::memory_order_relaxed) < expected) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  v_int64 messages = argc > 1 ? std::atoll(argv[1]) : 200000;
+  v_uint16 port = static_cast<v_uint16>(argc > 2 ? std::atoi(argv[2]) : 8011);
+
+  oatpp::Environment::init();
+  {
+    auto executor = std::make_shared<oatpp::async::Executor>(4, 1, 1);
+
+    auto single = oatpp::websocket::AsyncConnectionHandler::createShared(executor);
+    single->setSocketInstanceListener(std::make_shared<CountingSocketListener>(createMapper(false)));
+    auto coalesced = oatpp::websocket::AsyncConnectionHandler::createShared(executor);
+    coalesced->setSocketInstanceListener(std::make_shared<CountingSocketListener>(createMapper(true)));
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    router->addController(std::make_shared<WebSocketController>(
+        std::make_shared<oatpp::web::mime::ContentMappers>(), single, coalesced));
+
+    auto serverProvider = oatpp::network::tcp::server::ConnectionProvider::createShared({"localhost", port});
+    auto httpHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+    oatpp::network::Server server(serverProvider, httpHandler);
+    std::thread serverThread([&server]() { server.run(); });
+
+    auto clientProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"localhost", port});
+    auto connector = oatpp::websocket::Connector::createShared(clientProvider);
+
+    std::cout << "mode, objects per message, messages, objects/s" << std::endl;
+    struct Mode { const char* name; const char* path; v_int32 batch; };
+    for (const Mode& mode : {Mode{"single", "ws/single", 1}, Mode{"coalesced", "ws/coalesced", 16}}) {
+      v_int64 rounds = mode.batch > 1 ? messages / mode.batch : messages;
+      v_int64 expected = rounds * mode.batch;
+      g_received.store(0);
+      auto start = std::chrono::steady_clock::now();
+      executor->execute<SendCoroutine>(connector, mode.path, rounds, mode.batch);
+      if (!waitFor(expected)) {
+        std::cerr << mode.name << ": timed out after " << g_received.load() << " objects" << std::endl;
+        break;
+      }
+      auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << mode.name << ", " << mode.batch << ", " << rounds << ", "
+                << static_cast<v_int64>(static_cast<double>(expected) / elapsed) << std::endl;
+    }
+
+    server.stop();
+    httpHandler->stop();
+    serverProvider->stop();
+    clientProvider->stop();
+    serverThread.join();
+    executor->waitTasksFinished(std::chrono::seconds(5));
+    executor->stop();
+    executor->join();
+  }
+  oatpp::Environment::destroy();
+  return 0;
+}
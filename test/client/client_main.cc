@@ -1,17 +1,35 @@
 #include "oatpp-flatbuffers/ObjectMapper.hpp"
 #include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp-flatbuffers/FlatBuffersBody.hpp"
+#include "oatpp-flatbuffers/RpcClient.hpp"
 #include "oatpp/web/client/ApiClient.hpp"
 #include "oatpp/web/client/HttpRequestExecutor.hpp"
-#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
 #include "oatpp/network/tcp/client/ConnectionProvider.hpp"
 #include "oatpp/async/Executor.hpp"
 #include "oatpp/macro/codegen.hpp"
 #include "monster_test_generated.h"
+#include "monster_test_bfbs_generated.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <string.h>
+#define strncasecmp _strnicmp
+#else
+#include <strings.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <iostream>
-#include <vector>
 #include <memory>
+#include <random>
+#include <string>
 #include <thread>
-#include <chrono>
+#include <vector>
 
 namespace ofb = oatpp::flatbuffers;
 
@@ -28,14 +46,9 @@ public:
   
   // 手动实现 POST /monster，因为需要发送二进制数据
   oatpp::async::CoroutineStarterForResult<const std::shared_ptr<oatpp::web::protocol::http::incoming::Response>&>
-  PostMonster(const std::shared_ptr<std::vector<uint8_t>>& buffer) {
-    // 将 vector<uint8_t> 转换为 oatpp::String
-    oatpp::String bodyString(reinterpret_cast<const char*>(buffer->data()), buffer->size());
-    
-    // 创建请求体
-    auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(
-        bodyString, 
-        "application/x-flatbuffers");
+  PostMonster(const ofb::Object<MyGame::Example::Monster>& monster) {
+    // 请求体直接引用 Object<Monster> 的 buffer，不再拷贝到 oatpp::String
+    auto body = ofb::FlatBuffersBody::createShared(monster);
     
     // 创建请求头
     oatpp::web::protocol::http::Headers headers;
@@ -68,11 +81,14 @@ public:
 class ClientCoroutine : public oatpp::async::Coroutine<ClientCoroutine> {
 private:
   std::shared_ptr<MonsterClient> m_client;
-  std::shared_ptr<std::vector<uint8_t>> m_monsterBuffer;
+  std::shared_ptr<ofb::RpcClient> m_rpc;
+  ofb::Object<MyGame::Example::Monster> m_monster;
+  v_int64 m_streamed = 0;
   
 public:
-  ClientCoroutine(const std::shared_ptr<MonsterClient>& client)
-      : m_client(client) {}
+  ClientCoroutine(const std::shared_ptr<MonsterClient>& client,
+                  const std::shared_ptr<ofb::RpcClient>& rpc)
+      : m_client(client), m_rpc(rpc) {}
   
   Action act() override {
     // 首先调用 GET /monster 获取 Monster
@@ -146,14 +162,12 @@ public:
     ::flatbuffers::FlatBufferBuilder fbb;
     auto monsterOffset = MyGame::Example::CreateMonster(fbb, monsterT.get());
     fbb.Finish(monsterOffset);
-    // 保存 Monster buffer，用于后续的 POST
-    m_monsterBuffer = std::make_shared<std::vector<uint8_t>>(
-        reinterpret_cast<const uint8_t*>(fbb.GetBufferPointer()),
-        reinterpret_cast<const uint8_t*>(fbb.GetBufferPointer() + fbb.GetSize()));
+    // 接管 builder 的内存作为 Monster，用于后续的 POST（零拷贝）
+    m_monster = ofb::Object<MyGame::Example::Monster>::fromBuilder(std::move(fbb));
     
     // 现在调用 POST /monster 发送 Monster
     // PostMonster 返回的是 CoroutineStarterForResult
-    return m_client->PostMonster(m_monsterBuffer)
+    return m_client->PostMonster(m_monster)
         .callbackTo(&ClientCoroutine::onPostResponse);
   }
   
@@ -167,6 +181,34 @@ public:
     }
     
     std::cout << "POST /monster succeeded!" << std::endl;
+
+    // server streaming rpc：请求 3 个 Monster，逐帧解码
+    flatbuffers::FlatBufferBuilder fbb;
+    fbb.Finish(MyGame::Example::CreateStat(fbb, 0, 0, 3));
+    return m_rpc->call("Retrieve", ofb::Object<MyGame::Example::Stat>::fromBuilder(std::move(fbb)))
+        .callbackTo(&ClientCoroutine::onRetrieveResponse);
+  }
+
+  Action onRetrieveResponse(
+      const std::shared_ptr<oatpp::web::protocol::http::incoming::Response>&
+          response) {
+    if (response->getStatusCode() != 200) {
+      std::cerr << "Retrieve failed with status: "
+                << response->getStatusCode() << std::endl;
+      return finish();
+    }
+    return m_rpc->readFrames<MyGame::Example::Monster>(response,
+        [this](const ofb::Object<MyGame::Example::Monster>& monster) {
+          ++m_streamed;
+          std::cout << "Retrieve frame - Name: "
+                    << (monster->name() ? monster->name()->c_str() : "null") << std::endl;
+          return true;
+        })
+        .next(yieldTo(&ClientCoroutine::onRetrieveDone));
+  }
+
+  Action onRetrieveDone() {
+    std::cout << "Retrieve streamed " << m_streamed << " monsters" << std::endl;
     return finish();
   }
   
@@ -176,7 +218,640 @@ public:
   }
 };
 
-void runClient() {
+// 命令行参数；--mode demo 为原来的单次演示，--mode load 为压测
+struct Options {
+  std::string mode = "demo";
+  std::string host = "localhost";
+  v_uint16 port = 8000;
+  v_int32 connections = 16;
+  v_int32 pipeline = 1;
+  v_int32 durationSeconds = 10;
+  v_int32 warmupSeconds = 2;
+  v_int32 payload = 256;
+  v_int32 batchItems = 16;
+  double rate = 0;
+  std::string mix = "get:70,post:20,batch:10";
+  std::string acceptEncoding;
+};
+
+static void printUsage(const char* program) {
+  std::cout << "Usage: " << program << " [options]\n"
+            << "  --mode demo|load        demo: one GET/POST/rpc round trip (default); load: load generator\n"
+            << "  --host <host>           server host (default localhost)\n"
+            << "  --port <port>           server port (default 8000)\n"
+            << "  --connections <n>       concurrent keep-alive connections (default 16)\n"
+            << "  --pipeline <n>          requests in flight per connection (default 1)\n"
+            << "  --duration <s>          measured seconds (default 10)\n"
+            << "  --warmup <s>            seconds before recording starts (default 2)\n"
+            << "  --mix <op:w,...>        request mix of get, post, batch (default get:70,post:20,batch:10)\n"
+            << "  --payload <bytes>       Monster.inventory size of posted monsters (default 256)\n"
+            << "  --batch-items <n>       monsters per POST /monsters/batch body (default 16)\n"
+            << "  --accept-encoding <v>   Accept-Encoding sent with GET /monster (default none)\n"
+            << "  --rate <req/s>          constant total request rate, split over connections; latency is\n"
+            << "                          measured from the intended send time (default 0: closed loop)\n"
+            << "\n"
+            << "Closed loop (no --rate) sends a request only after a response arrives, so a stalled server\n"
+            << "also stalls the client and the stall is hidden from the percentiles (coordinated omission).\n"
+            << "Use --rate for latency at a fixed arrival rate.\n";
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      return false;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      return false;
+    }
+    std::string value = argv[++i];
+    if (arg == "--mode") options.mode = value;
+    else if (arg == "--host") options.host = value;
+    else if (arg == "--port") options.port = static_cast<v_uint16>(std::atoi(value.c_str()));
+    else if (arg == "--connections") options.connections = std::max(1, std::atoi(value.c_str()));
+    else if (arg == "--pipeline") options.pipeline = std::max(1, std::atoi(value.c_str()));
+    else if (arg == "--duration") options.durationSeconds = std::max(1, std::atoi(value.c_str()));
+    else if (arg == "--warmup") options.warmupSeconds = std::max(0, std::atoi(value.c_str()));
+    else if (arg == "--mix") options.mix = value;
+    else if (arg == "--payload") options.payload = std::max(0, std::atoi(value.c_str()));
+    else if (arg == "--batch-items") options.batchItems = std::max(1, std::atoi(value.c_str()));
+    else if (arg == "--accept-encoding") options.acceptEncoding = value;
+    else if (arg == "--rate") options.rate = std::max(0.0, std::atof(value.c_str()));
+    else {
+      std::cerr << "Unknown option " << arg << std::endl;
+      return false;
+    }
+  }
+  if (options.mode != "demo" && options.mode != "load") {
+    std::cerr << "Unknown mode " << options.mode << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/*
+ * HDR 风格的延迟直方图（纳秒）：小于 2^SUB_BITS 的值精确计数，
+ * 之后每个 2 的幂区间再线性分成 2^(SUB_BITS - 1) 格，相对误差 < 1%，
+ * 覆盖 64 位全范围；固定大小，记录无分配，可按格相加合并。
+ */
+class LatencyHistogram {
+public:
+  static constexpr v_int32 SUB_BITS = 8;
+  static constexpr v_int64 SUB_COUNT = v_int64(1) << SUB_BITS;
+  static constexpr v_int64 HALF_COUNT = SUB_COUNT / 2;
+  static constexpr v_int64 BUCKET_COUNT = SUB_COUNT + (64 - SUB_BITS) * HALF_COUNT;
+private:
+  std::vector<v_int64> m_counts;
+  v_int64 m_total = 0;
+  v_int64 m_max = 0;
+  double m_sum = 0;
+private:
+
+  // value 非 0
+  static v_int32 mostSignificantBit(v_uint64 value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<v_int32>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    v_int32 msb = 0;
+    while (value >>= 1) ++msb;
+    return msb;
+#endif
+  }
+
+  static v_int64 indexOf(v_uint64 value) {
+    if (value < static_cast<v_uint64>(SUB_COUNT)) {
+      return static_cast<v_int64>(value);
+    }
+    v_int32 msb = mostSignificantBit(value);
+    v_int32 shift = msb - (SUB_BITS - 1);
+    v_int64 sub = static_cast<v_int64>(value >> shift);
+    return SUB_COUNT + (shift - 1) * HALF_COUNT + (sub - HALF_COUNT);
+  }
+
+  // 该格内的最大值（与 HdrHistogram 的 highestEquivalentValue 一致）
+  static v_int64 highestValueAt(v_int64 index) {
+    if (index < SUB_COUNT) {
+      return index;
+    }
+    v_int64 offset = index - SUB_COUNT;
+    v_int32 shift = static_cast<v_int32>(offset / HALF_COUNT) + 1;
+    v_uint64 sub = static_cast<v_uint64>(offset % HALF_COUNT + HALF_COUNT);
+    return static_cast<v_int64>(((sub + 1) << shift) - 1);
+  }
+
+public:
+
+  LatencyHistogram()
+    : m_counts(static_cast<size_t>(BUCKET_COUNT), 0)
+  {}
+
+  void record(v_int64 nanos) {
+    if (nanos < 0) nanos = 0;
+    ++m_counts[static_cast<size_t>(indexOf(static_cast<v_uint64>(nanos)))];
+    ++m_total;
+    m_max = std::max(m_max, nanos);
+    m_sum += static_cast<double>(nanos);
+  }
+
+  void add(const LatencyHistogram& other) {
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+      m_counts[i] += other.m_counts[i];
+    }
+    m_total += other.m_total;
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+  }
+
+  v_int64 getTotal() const { return m_total; }
+  v_int64 getMax() const { return m_max; }
+  double getMean() const { return m_total > 0 ? m_sum / static_cast<double>(m_total) : 0; }
+
+  /**
+   * 百分位对应的值（纳秒），percentile 取 0 ~ 100。
+   */
+  v_int64 getValueAtPercentile(double percentile) const {
+    if (m_total == 0) return 0;
+    v_int64 rank = static_cast<v_int64>(percentile / 100.0 * static_cast<double>(m_total) + 0.5);
+    rank = std::min(std::max<v_int64>(rank, 1), m_total);
+    v_int64 seen = 0;
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+      seen += m_counts[i];
+      if (seen >= rank) {
+        return std::min(highestValueAt(static_cast<v_int64>(i)), m_max);
+      }
+    }
+    return m_max;
+  }
+
+};
+
+enum class LoadOp : v_int32 {
+  GET = 0,
+  POST = 1,
+  BATCH = 2
+};
+
+static constexpr v_int32 LOAD_OP_COUNT = 3;
+static const char* const LOAD_OP_NAMES[LOAD_OP_COUNT] = {"get", "post", "batch"};
+
+static bool parseMix(const std::string& mix, std::vector<v_int32>& weights) {
+  weights.assign(LOAD_OP_COUNT, 0);
+  size_t begin = 0;
+  while (begin < mix.size()) {
+    size_t end = mix.find(',', begin);
+    if (end == std::string::npos) end = mix.size();
+    std::string token = mix.substr(begin, end - begin);
+    size_t colon = token.find(':');
+    std::string name = token.substr(0, colon);
+    v_int32 weight = colon == std::string::npos ? 1 : std::atoi(token.c_str() + colon + 1);
+    auto it = std::find_if(std::begin(LOAD_OP_NAMES), std::end(LOAD_OP_NAMES),
+                           [&name](const char* op) { return name == op; });
+    if (it == std::end(LOAD_OP_NAMES) || weight < 0) {
+      std::cerr << "Invalid mix entry '" << token << "'" << std::endl;
+      return false;
+    }
+    weights[static_cast<size_t>(it - std::begin(LOAD_OP_NAMES))] = weight;
+    begin = end + 1;
+  }
+  v_int32 sum = 0;
+  for (v_int32 w : weights) sum += w;
+  if (sum <= 0) {
+    std::cerr << "Request mix has no weight" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static void addLoadMonster(flatbuffers::FlatBufferBuilder& fbb, v_int32 payload, v_int32 index, bool sizePrefixed) {
+  std::vector<uint8_t> inventory(static_cast<size_t>(payload));
+  for (size_t i = 0; i < inventory.size(); ++i) {
+    inventory[i] = static_cast<uint8_t>(i + static_cast<size_t>(index));
+  }
+  auto name = fbb.CreateString("load-" + std::to_string(index));
+  auto inv = fbb.CreateVector(inventory);
+  MyGame::Example::Vec3 pos(1.0f, 2.0f, 3.0f, 3.0, MyGame::Example::Color_Green, MyGame::Example::Test(5, 6));
+  MyGame::Example::MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_hp(80);
+  mb.add_mana(150);
+  mb.add_pos(&pos);
+  mb.add_inventory(inv);
+  if (sizePrefixed) {
+    MyGame::Example::FinishSizePrefixedMonsterBuffer(fbb, mb.Finish());
+  } else {
+    MyGame::Example::FinishMonsterBuffer(fbb, mb.Finish());
+  }
+}
+
+static std::string renderRequest(const Options& options, const char* method, const char* path,
+                                 const std::string& headers, const std::string& body) {
+  std::string request;
+  request.reserve(256 + body.size());
+  request.append(method).append(" ").append(path).append(" HTTP/1.1\r\n");
+  request.append("Host: ").append(options.host).append(":").append(std::to_string(options.port)).append("\r\n");
+  request.append("Connection: keep-alive\r\n");
+  request.append(headers);
+  if (std::strcmp(method, "GET") != 0) {
+    request.append("Content-Type: application/x-flatbuffers\r\n");
+    request.append("Content-Length: ").append(std::to_string(body.size())).append("\r\n");
+  }
+  request.append("\r\n").append(body);
+  return request;
+}
+
+// 每种请求预先编码为完整的 HTTP 报文，压测时只做 write，客户端开销与 mapper 无关
+static std::vector<std::string> renderRequests(const Options& options) {
+  std::vector<std::string> requests(LOAD_OP_COUNT);
+
+  std::string getHeaders = "Accept: application/x-flatbuffers\r\n";
+  if (!options.acceptEncoding.empty()) {
+    getHeaders += "Accept-Encoding: " + options.acceptEncoding + "\r\n";
+  }
+  requests[static_cast<size_t>(LoadOp::GET)] = renderRequest(options, "GET", "/monster", getHeaders, "");
+
+  // POST /monster 会逐个打印收到的 Monster，压测改走不打印的 /monster/encoded（无 Content-Encoding 即未压缩）
+  flatbuffers::FlatBufferBuilder fbb;
+  addLoadMonster(fbb, options.payload, 0, false);
+  requests[static_cast<size_t>(LoadOp::POST)] = renderRequest(options, "POST", "/monster/encoded", "",
+      std::string(reinterpret_cast<const char*>(fbb.GetBufferPointer()), fbb.GetSize()));
+
+  std::string batch;
+  for (v_int32 i = 0; i < options.batchItems; ++i) {
+    fbb.Clear();
+    addLoadMonster(fbb, options.payload, i, true);
+    batch.append(reinterpret_cast<const char*>(fbb.GetBufferPointer()), fbb.GetSize());
+  }
+  requests[static_cast<size_t>(LoadOp::BATCH)] = renderRequest(options, "POST", "/monsters/batch", "", batch);
+
+  return requests;
+}
+
+struct LoadClock {
+  std::chrono::steady_clock::time_point recordFrom;
+  std::chrono::steady_clock::time_point stopAt;
+};
+
+/*
+ * 一个 keep-alive 连接上的负载；响应按发送顺序返回，用 FIFO 对应起始时间。
+ * - 闭环（默认）：始终保持 pipeline 个请求在途，每收到一个响应就补发一个；
+ *   服务端停顿时客户端也跟着停发，停顿期间本应发出的请求不被计入（coordinated omission）。
+ * - 定速（--rate）：按固定间隔排定发送时刻，延迟从排定时刻起算；在途已满或等待响应而晚发的请求，
+ *   其排队时间同样计入延迟。
+ * 使用阻塞 socket 与独立线程，客户端不经过被测的 Executor。
+ */
+class LoadConnection {
+private:
+  typedef oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> Connection;
+  struct InFlight {
+    LoadOp op;
+    // 闭环为实际发送时刻，定速为排定的发送时刻
+    std::chrono::steady_clock::time_point sentAt;
+  };
+private:
+  const Options& m_options;
+  const std::vector<std::string>& m_requests;
+  std::shared_ptr<oatpp::network::ClientConnectionProvider> m_provider;
+  std::vector<v_int32> m_cumulativeWeights;
+  std::mt19937 m_random;
+  Connection m_connection;
+  std::deque<InFlight> m_inFlight;
+  std::string m_in;
+  size_t m_pos = 0;
+public:
+  std::vector<LatencyHistogram> histograms;
+  std::vector<v_int64> errors;
+  v_int64 bytesSent = 0;
+  v_int64 bytesReceived = 0;
+  v_int64 reconnects = 0;
+private:
+
+  LoadOp nextOp() {
+    std::uniform_int_distribution<v_int32> dist(0, m_cumulativeWeights.back() - 1);
+    v_int32 pick = dist(m_random);
+    v_int32 op = 0;
+    while (pick >= m_cumulativeWeights[static_cast<size_t>(op)]) ++op;
+    return static_cast<LoadOp>(op);
+  }
+
+  bool connect() {
+    m_in.clear();
+    m_pos = 0;
+    try {
+      m_connection = m_provider->get();
+    } catch (const std::exception& e) {
+      std::cerr << "connect failed: " << e.what() << std::endl;
+      m_connection = Connection();
+    }
+    return m_connection.object != nullptr;
+  }
+
+  void close() {
+    if (m_connection.object && m_connection.invalidator) {
+      m_connection.invalidator->invalidate(m_connection.object);
+    }
+    m_connection = Connection();
+  }
+
+  bool send(LoadOp op, std::chrono::steady_clock::time_point startedAt) {
+    const std::string& request = m_requests[static_cast<size_t>(op)];
+    m_inFlight.push_back({op, startedAt});
+    auto res = m_connection.object->writeExactSizeDataSimple(request.data(), static_cast<v_buff_size>(request.size()));
+    if (res != static_cast<v_io_size>(request.size())) {
+      return false;
+    }
+    bytesSent += res;
+    return true;
+  }
+
+  bool fill() {
+    char chunk[16 * 1024];
+    auto res = m_connection.object->readSimple(chunk, sizeof(chunk));
+    if (res > 0) {
+      m_in.append(chunk, static_cast<size_t>(res));
+      bytesReceived += res;
+      return true;
+    }
+    return res == oatpp::IOError::RETRY_READ || res == oatpp::IOError::RETRY_WRITE;
+  }
+
+  // 读出一个完整响应，返回状态码；连接断开或响应无法解析返回 -1
+  v_int32 readResponse() {
+    size_t headerEnd;
+    while ((headerEnd = m_in.find("\r\n\r\n", m_pos)) == std::string::npos) {
+      if (!fill()) return -1;
+    }
+    if (headerEnd - m_pos < 12 || std::strncmp(m_in.data() + m_pos, "HTTP/1.", 7) != 0) {
+      return -1;
+    }
+    v_int32 status = std::atoi(m_in.data() + m_pos + 9);
+    v_int64 contentLength = 0;
+    size_t line = m_in.find("\r\n", m_pos) + 2;
+    while (line < headerEnd) {
+      size_t next = m_in.find("\r\n", line);
+      const char* header = m_in.data() + line;
+      if (next - line > 15 && strncasecmp(header, "Content-Length:", 15) == 0) {
+        contentLength = std::strtoll(header + 15, nullptr, 10);
+      } else if (next - line > 18 && strncasecmp(header, "Transfer-Encoding:", 18) == 0) {
+        std::cerr << "chunked responses are not supported by the load generator" << std::endl;
+        return -1;
+      }
+      line = next + 2;
+    }
+    size_t responseEnd = headerEnd + 4 + static_cast<size_t>(contentLength);
+    while (m_in.size() < responseEnd) {
+      if (!fill()) return -1;
+    }
+    m_pos = responseEnd;
+    if (m_pos == m_in.size()) {
+      m_in.clear();
+      m_pos = 0;
+    } else if (m_pos > 64 * 1024) {
+      m_in.erase(0, m_pos);
+      m_pos = 0;
+    }
+    return status;
+  }
+
+  // 队首请求收到响应：预热之后发出的按状态码记入延迟或错误
+  void complete(v_int32 status, std::chrono::steady_clock::time_point receivedAt, const LoadClock& clock) {
+    InFlight request = m_inFlight.front();
+    m_inFlight.pop_front();
+    if (request.sentAt < clock.recordFrom) {
+      return;
+    }
+    if (status == 200) {
+      histograms[static_cast<size_t>(request.op)].record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(receivedAt - request.sentAt).count());
+    } else {
+      ++errors[static_cast<size_t>(request.op)];
+    }
+  }
+
+  // 连接失效：在途请求记为错误，重新建连
+  void dropConnection(const LoadClock& clock) {
+    for (const auto& request : m_inFlight) {
+      if (request.sentAt >= clock.recordFrom) {
+        ++errors[static_cast<size_t>(request.op)];
+      }
+    }
+    m_inFlight.clear();
+    close();
+    ++reconnects;
+  }
+
+public:
+
+  LoadConnection(const Options& options,
+                 const std::vector<std::string>& requests,
+                 const std::vector<v_int32>& weights,
+                 const std::shared_ptr<oatpp::network::ClientConnectionProvider>& provider,
+                 v_uint32 seed)
+    : m_options(options)
+    , m_requests(requests)
+    , m_provider(provider)
+    , m_random(seed)
+    , histograms(LOAD_OP_COUNT)
+    , errors(LOAD_OP_COUNT, 0)
+  {
+    v_int32 sum = 0;
+    for (v_int32 w : weights) {
+      sum += w;
+      m_cumulativeWeights.push_back(sum);
+    }
+  }
+
+  void run(const LoadClock& clock) {
+    if (m_options.rate > 0) {
+      runConstantRate(clock);
+      return;
+    }
+    while (std::chrono::steady_clock::now() < clock.stopAt) {
+      if (!m_connection.object && !connect()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        continue;
+      }
+      bool alive = true;
+      while (alive && static_cast<v_int32>(m_inFlight.size()) < m_options.pipeline) {
+        alive = send(nextOp(), std::chrono::steady_clock::now());
+      }
+      while (alive && !m_inFlight.empty()) {
+        v_int32 status = readResponse();
+        if (status < 0) {
+          alive = false;
+          break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        complete(status, now, clock);
+        // 到点后不再补发，只收完在途的响应
+        if (now < clock.stopAt) {
+          alive = send(nextOp(), now);
+        }
+      }
+      if (!alive) {
+        dropConnection(clock);
+      }
+    }
+    close();
+  }
+
+  void runConstantRate(const LoadClock& clock) {
+    double perConnection = m_options.rate / static_cast<double>(m_options.connections);
+    std::chrono::nanoseconds interval(std::max<v_int64>(1, static_cast<v_int64>(1e9 / perConnection)));
+    // 各连接的排定时刻错开，避免同时发出
+    std::uniform_int_distribution<v_int64> phase(0, interval.count() - 1);
+    auto nextSendAt = std::chrono::steady_clock::now() + std::chrono::nanoseconds(phase(m_random));
+    while (std::chrono::steady_clock::now() < clock.stopAt) {
+      if (!m_connection.object && !connect()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        continue;
+      }
+      bool alive = true;
+      auto now = std::chrono::steady_clock::now();
+      // 补发所有已到排定时刻的请求（受 pipeline 限制）；晚发的请求仍以排定时刻计时
+      while (alive && nextSendAt <= now && nextSendAt < clock.stopAt &&
+             static_cast<v_int32>(m_inFlight.size()) < m_options.pipeline) {
+        alive = send(nextOp(), nextSendAt);
+        nextSendAt += interval;
+      }
+      if (alive && m_inFlight.empty()) {
+        std::this_thread::sleep_until(std::min(nextSendAt, clock.stopAt));
+        continue;
+      }
+      if (alive) {
+        v_int32 status = readResponse();
+        if (status < 0) {
+          alive = false;
+        } else {
+          complete(status, std::chrono::steady_clock::now(), clock);
+        }
+      }
+      if (!alive) {
+        dropConnection(clock);
+      }
+    }
+    // 收完在途的响应
+    while (m_connection.object && !m_inFlight.empty()) {
+      v_int32 status = readResponse();
+      if (status < 0) {
+        dropConnection(clock);
+        break;
+      }
+      complete(status, std::chrono::steady_clock::now(), clock);
+    }
+    close();
+  }
+
+};
+
+static void printLatencyRow(const char* name, const LatencyHistogram& histogram, v_int64 errors) {
+  auto micros = [](v_int64 nanos) { return static_cast<double>(nanos) / 1000.0; };
+  std::printf("%s, %lld, %lld, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f\n",
+              name,
+              static_cast<long long>(histogram.getTotal()),
+              static_cast<long long>(errors),
+              micros(static_cast<v_int64>(histogram.getMean())),
+              micros(histogram.getValueAtPercentile(50.0)),
+              micros(histogram.getValueAtPercentile(90.0)),
+              micros(histogram.getValueAtPercentile(99.0)),
+              micros(histogram.getValueAtPercentile(99.9)),
+              micros(histogram.getMax()));
+}
+
+int runLoad(const Options& options) {
+  std::vector<v_int32> weights;
+  if (!parseMix(options.mix, weights)) {
+    return 1;
+  }
+
+  oatpp::Environment::init();
+  int exitCode = 0;
+  {
+    auto provider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+        {options.host, options.port});
+    auto requests = renderRequests(options);
+
+    std::vector<std::unique_ptr<LoadConnection>> connections;
+    for (v_int32 i = 0; i < options.connections; ++i) {
+      connections.emplace_back(new LoadConnection(options, requests, weights, provider, static_cast<v_uint32>(i + 1)));
+    }
+
+    LoadClock clock;
+    auto start = std::chrono::steady_clock::now();
+    clock.recordFrom = start + std::chrono::seconds(options.warmupSeconds);
+    clock.stopAt = clock.recordFrom + std::chrono::seconds(options.durationSeconds);
+
+    std::cout << "load: " << options.host << ":" << options.port
+              << ", connections=" << options.connections
+              << ", pipeline=" << options.pipeline
+              << ", warmup=" << options.warmupSeconds << "s"
+              << ", duration=" << options.durationSeconds << "s"
+              << ", mix=" << options.mix
+              << ", payload=" << options.payload
+              << ", batch-items=" << options.batchItems;
+    if (options.rate > 0) {
+      std::cout << ", rate=" << options.rate << " req/s";
+    }
+    std::cout << std::endl;
+
+    std::vector<std::thread> threads;
+    for (auto& connection : connections) {
+      LoadConnection* c = connection.get();
+      threads.emplace_back([c, &clock]() { c->run(clock); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - clock.recordFrom).count();
+
+    std::vector<LatencyHistogram> histograms(LOAD_OP_COUNT);
+    std::vector<v_int64> errors(LOAD_OP_COUNT, 0);
+    LatencyHistogram total;
+    v_int64 totalErrors = 0;
+    v_int64 bytesSent = 0;
+    v_int64 bytesReceived = 0;
+    v_int64 reconnects = 0;
+    for (auto& connection : connections) {
+      for (v_int32 op = 0; op < LOAD_OP_COUNT; ++op) {
+        histograms[static_cast<size_t>(op)].add(connection->histograms[static_cast<size_t>(op)]);
+        errors[static_cast<size_t>(op)] += connection->errors[static_cast<size_t>(op)];
+      }
+      bytesSent += connection->bytesSent;
+      bytesReceived += connection->bytesReceived;
+      reconnects += connection->reconnects;
+    }
+
+    std::cout << "op, requests, errors, mean us, p50 us, p90 us, p99 us, p999 us, max us" << std::endl;
+    for (v_int32 op = 0; op < LOAD_OP_COUNT; ++op) {
+      if (weights[static_cast<size_t>(op)] == 0) continue;
+      printLatencyRow(LOAD_OP_NAMES[op], histograms[static_cast<size_t>(op)], errors[static_cast<size_t>(op)]);
+      total.add(histograms[static_cast<size_t>(op)]);
+      totalErrors += errors[static_cast<size_t>(op)];
+    }
+    printLatencyRow("all", total, totalErrors);
+
+    std::printf("throughput: %.0f req/s, out %.2f MB/s, in %.2f MB/s, reconnects %lld\n",
+                static_cast<double>(total.getTotal()) / seconds,
+                static_cast<double>(bytesSent) / seconds / (1024.0 * 1024.0),
+                static_cast<double>(bytesReceived) / seconds / (1024.0 * 1024.0),
+                static_cast<long long>(reconnects));
+
+    if (total.getTotal() == 0) {
+      std::cerr << "No successful requests; is oatpp_flatbuffers_server running on "
+                << options.host << ":" << options.port << "?" << std::endl;
+      exitCode = 1;
+    }
+    provider->stop();
+  }
+  oatpp::Environment::destroy();
+  return exitCode;
+}
+
+void runClient(const Options& options) {
   // 初始化 oatpp
   oatpp::Environment::init();
   
@@ -186,7 +861,7 @@ void runClient() {
   // 创建连接提供者
   auto connectionProvider =
       oatpp::network::tcp::client::ConnectionProvider::createShared(
-          {"localhost", 8000});
+          {options.host, options.port});
   
   // 创建重试策略
   auto retryPolicy =
@@ -200,14 +875,20 @@ void runClient() {
   
   // 创建客户端
   auto client = MonsterClient::createShared(requestExecutor, flatbuffersMapper);
+
+  // 由 schema 中的 rpc_service MonsterStorage 生成的 rpc 客户端
+  auto schema = ofb::CompiledSchema::compile(
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  auto rpc = ofb::RpcClient::createShared(
+      schema, "MyGame.Example.MonsterStorage", requestExecutor, flatbuffersMapper, "/rpc");
   
   // 创建异步执行器
   auto executor = std::make_shared<oatpp::async::Executor>(
-      4 /* threads */, 1 /* additional threads */,
-      1 /* max tasks per thread */);
+      4 /* data-processing threads */, 1 /* I/O threads */, 1 /* timer threads */);
   
   // 执行客户端协程
-  executor->execute<ClientCoroutine>(client);
+  executor->execute<ClientCoroutine>(client, rpc);
   executor->execute<WaitCoroutine>();
   
   // 等待执行完成
@@ -221,8 +902,16 @@ void runClient() {
   oatpp::Environment::destroy();
 }
 
-int main() {
-  runClient();
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if (options.mode == "load") {
+    return runLoad(options);
+  }
+  runClient(options);
   return 0;
 }
 
@@ -1,11 +1,39 @@
 #include "oatpp-flatbuffers/ObjectMapper.hpp"
+#include "oatpp-flatbuffers/BatchProcessor.hpp"
 #include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp-flatbuffers/Arena.hpp"
+#include "oatpp-flatbuffers/BufferPool.hpp"
+#include "oatpp-flatbuffers/BuilderPool.hpp"
+#include "oatpp-flatbuffers/ContentEncoding.hpp"
+#include "oatpp-flatbuffers/FlatBuffersBody.hpp"
+#include "oatpp-flatbuffers/JsonTranscodingMapper.hpp"
+#include "oatpp-flatbuffers/Metrics.hpp"
+#include "oatpp-flatbuffers/FlatBuffersStreamBody.hpp"
+#include "oatpp-flatbuffers/FrameReader.hpp"
+#include "oatpp-flatbuffers/FrameSink.hpp"
+#include "oatpp-flatbuffers/Projection.hpp"
+#include "oatpp-flatbuffers/RpcServiceInfo.hpp"
+#include "oatpp-flatbuffers/SchemaCache.hpp"
+#include "oatpp-flatbuffers/ZstdDictionary.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
 #include "oatpp/Types.hpp"
 #include "monster_test_generated.h"
+#include "monster_test_bfbs_generated.h"
 
+#ifdef OATPP_FLATBUFFERS_WITH_WEBSOCKET
+#include "oatpp-flatbuffers/WebSocketTransport.hpp"
+#include "oatpp/provider/Provider.hpp"
+#include <functional>
+#endif
+
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace ofb = oatpp::flatbuffers;
@@ -54,8 +82,1377 @@ static void test_read_raw_caret_copies_underlying() {
   }
 }
 
+static void test_read_rejects_unverifiable_buffer() {
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  std::vector<uint8_t> garbage = {0xFF, 0xFF, 0xFF, 0x7F, 0x01, 0x02, 0x03, 0x04};
+  oatpp::String body(reinterpret_cast<const char*>(garbage.data()),
+                     static_cast<v_buff_size>(garbage.size()));
+  oatpp::utils::parser::Caret caret(body);
+  oatpp::data::mapping::ErrorStack errorStack;
+  auto result = mapper->read(caret, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack);
+  if (result || errorStack.empty()) {
+    throw std::runtime_error("expected verification failure for garbage buffer");
+  }
+  if (caret.getPosition() != 0) {
+    throw std::runtime_error("caret must not be consumed when verification fails");
+  }
+}
+
+static void test_read_lazy_verify_on_first_access() {
+  ofb::ObjectMapper::Config config;
+  config.lazyVerify = true;
+  auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+  std::vector<uint8_t> garbage = {0xFF, 0xFF, 0xFF, 0x7F, 0x01, 0x02, 0x03, 0x04};
+  oatpp::String body(reinterpret_cast<const char*>(garbage.data()),
+                     static_cast<v_buff_size>(garbage.size()));
+  oatpp::utils::parser::Caret caret(body);
+  auto forwarded = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  if (!forwarded || forwarded.get()->getBufferSize() != static_cast<v_buff_size>(garbage.size())) {
+    throw std::runtime_error("lazy verify must not reject the buffer before access");
+  }
+  bool threw = false;
+  try {
+    forwarded->hp();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  if (!threw) {
+    throw std::runtime_error("first access to an invalid lazily verified buffer must throw");
+  }
+
+  auto raw = buildMinimalMonster();
+  oatpp::String good(reinterpret_cast<const char*>(raw->data()),
+                     static_cast<v_buff_size>(raw->size()));
+  oatpp::utils::parser::Caret goodCaret(good);
+  auto monster = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(goodCaret);
+  if (!monster || monster->hp() != 42 || monster->mana() != 7) {
+    throw std::runtime_error("valid lazily verified buffer must be readable");
+  }
+}
+
+static void test_read_verify_limits() {
+  ofb::ObjectMapper::Config config;
+  config.verifyOptions.maxSize = 8;
+  auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+  auto raw = buildMinimalMonster();
+  oatpp::String body(reinterpret_cast<const char*>(raw->data()),
+                     static_cast<v_buff_size>(raw->size()));
+  oatpp::utils::parser::Caret caret(body);
+  oatpp::data::mapping::ErrorStack errorStack;
+  auto result = mapper->read(caret, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack);
+  if (result || errorStack.empty()) {
+    throw std::runtime_error("expected maxSize limit to reject buffer");
+  }
+
+  auto readWith = [](const ofb::FlatBuffersVerifyOptions& options, const flatbuffers::FlatBufferBuilder& builder) {
+    ofb::ObjectMapper::Config limited;
+    limited.verifyOptions = options;
+    ofb::ObjectMapper limitedMapper(limited);
+    oatpp::String data(reinterpret_cast<const char*>(builder.GetBufferPointer()),
+                       static_cast<v_buff_size>(builder.GetSize()));
+    oatpp::utils::parser::Caret dataCaret(data);
+    oatpp::data::mapping::ErrorStack errors;
+    auto value = limitedMapper.read(dataCaret, ofb::Object<MyGame::Example::Monster>::Class::getType(), errors);
+    return value && errors.empty();
+  };
+
+  // enemy 链：每层 Monster 多一层表嵌套
+  flatbuffers::FlatBufferBuilder deep(1024);
+  flatbuffers::Offset<MyGame::Example::Monster> enemy;
+  for (int i = 0; i < 10; ++i) {
+    auto name = deep.CreateString("E");
+    MyGame::Example::MonsterBuilder mb(deep);
+    mb.add_name(name);
+    if (!enemy.IsNull()) mb.add_enemy(enemy);
+    enemy = mb.Finish();
+  }
+  MyGame::Example::FinishMonsterBuffer(deep, enemy);
+
+  // 同一层的大量子表：深度很浅，但表总数多
+  flatbuffers::FlatBufferBuilder wide(4096);
+  std::vector<flatbuffers::Offset<MyGame::Example::Monster>> children;
+  for (int i = 0; i < 32; ++i) {
+    auto name = wide.CreateString("C");
+    MyGame::Example::MonsterBuilder mb(wide);
+    mb.add_name(name);
+    children.push_back(mb.Finish());
+  }
+  auto childrenOffset = wide.CreateVector(children);
+  auto rootName = wide.CreateString("Root");
+  MyGame::Example::MonsterBuilder rootBuilder(wide);
+  rootBuilder.add_name(rootName);
+  rootBuilder.add_testarrayoftables(childrenOffset);
+  MyGame::Example::FinishMonsterBuffer(wide, rootBuilder.Finish());
+
+  ofb::FlatBuffersVerifyOptions defaults;
+  if (!readWith(defaults, deep) || !readWith(defaults, wide)) {
+    throw std::runtime_error("deep and wide buffers must pass the default limits");
+  }
+  ofb::FlatBuffersVerifyOptions shallow;
+  shallow.maxDepth = 4;
+  if (readWith(shallow, deep)) {
+    throw std::runtime_error("expected maxDepth limit to reject a nested enemy chain");
+  }
+  ofb::FlatBuffersVerifyOptions few;
+  few.maxTables = 8;
+  if (readWith(few, wide)) {
+    throw std::runtime_error("expected maxTables limit to reject a buffer with many tables");
+  }
+}
+
+static std::string buildSizePrefixedMonster(const char* name, int16_t hp) {
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto nameOffset = builder.CreateString(name);
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(nameOffset);
+  mb.add_hp(hp);
+  auto root = mb.Finish();
+  builder.FinishSizePrefixed(root);
+  return std::string(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+static void test_read_size_prefixed_consumes_one_frame() {
+  ofb::ObjectMapper::Config config;
+  config.sizePrefixed = true;
+  auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+  std::string first = buildSizePrefixedMonster("A", 11);
+  std::string second = buildSizePrefixedMonster("B", 22);
+  oatpp::String body(first + second);
+  oatpp::utils::parser::Caret caret(body);
+  auto m1 = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  if (!m1 || m1->hp() != 11 || caret.getPosition() != static_cast<v_buff_size>(first.size())) {
+    throw std::runtime_error("size-prefixed read must consume exactly one frame");
+  }
+  auto m2 = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  if (!m2 || m2->hp() != 22 || caret.canContinue()) {
+    throw std::runtime_error("size-prefixed read of second frame failed");
+  }
+  auto written = mapper->writeToString(m2);
+  if (!written || *written != second) {
+    throw std::runtime_error("size-prefixed write must emit prefix + buffer");
+  }
+}
+
+// FinishSizePrefixed 的帧：前缀之后的内容起点差 4 字节，pos（Vec3）按 8 字节对齐
+static std::string buildSizePrefixedMonsterWithPos(int16_t hp) {
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto name = builder.CreateString("P");
+  MyGame::Example::Vec3 pos(1.0f, 2.0f, 3.0f, 4.0, MyGame::Example::Color_Green, MyGame::Example::Test(5, 6));
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(hp);
+  mb.add_pos(&pos);
+  MyGame::Example::FinishSizePrefixedMonsterBuffer(builder, mb.Finish());
+  return std::string(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+class MonsterFrameReaderRunner : public oatpp::async::Coroutine<MonsterFrameReaderRunner> {
+private:
+  std::shared_ptr<oatpp::data::stream::InputStream> m_stream;
+  std::shared_ptr<ofb::ObjectMapper> m_mapper;
+  v_int64 m_contentLength;
+  v_int64* m_hpSum;
+  bool* m_failed;
+public:
+  MonsterFrameReaderRunner(const std::shared_ptr<oatpp::data::stream::InputStream>& stream,
+                           const std::shared_ptr<ofb::ObjectMapper>& mapper,
+                           v_int64 contentLength, v_int64* hpSum, bool* failed)
+    : m_stream(stream), m_mapper(mapper), m_contentLength(contentLength), m_hpSum(hpSum), m_failed(failed) {}
+
+  Action act() override {
+    v_int64* hpSum = m_hpSum;
+    return ofb::FrameReader<MyGame::Example::Monster>::start(m_stream, m_mapper,
+        [hpSum](const ofb::Object<MyGame::Example::Monster>& monster) -> oatpp::async::CoroutineStarter {
+          if (monster->pos() && monster->pos()->z() == 3.0f) {
+            *hpSum += monster->hp();
+          }
+          return nullptr;
+        }, m_contentLength).next(finish());
+  }
+
+  Action handleError(oatpp::async::Error* error) override {
+    *m_failed = true;
+    return error;
+  }
+};
+
+static void runFrameReader(const std::shared_ptr<oatpp::data::stream::InputStream>& stream,
+                           const std::shared_ptr<ofb::ObjectMapper>& mapper,
+                           v_int64 contentLength, v_int64& hpSum, bool& failed) {
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  executor->execute<MonsterFrameReaderRunner>(stream, mapper, contentLength, &hpSum, &failed);
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+}
+
+static void test_size_prefixed_frames_with_aligned_structs() {
+  std::string first = buildSizePrefixedMonsterWithPos(11);
+  std::string second = buildSizePrefixedMonsterWithPos(22);
+  oatpp::String body(first + second);
+
+  ofb::ObjectMapper::Config config;
+  config.sizePrefixed = true;
+  auto prefixedMapper = std::make_shared<ofb::ObjectMapper>(config);
+  oatpp::utils::parser::Caret caret(body);
+  auto single = prefixedMapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  if (!single || !single->pos() || single->pos()->test1() != 4.0 || single->hp() != 11) {
+    throw std::runtime_error("a FinishSizePrefixed frame with an 8-byte aligned struct must verify");
+  }
+
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  oatpp::utils::parser::Caret batchCaret(body);
+  auto batch = mapper->readFromCaret<oatpp::List<ofb::Object<MyGame::Example::Monster>>>(batchCaret);
+  if (!batch || batch->size() != 2) {
+    throw std::runtime_error("batch read of FinishSizePrefixed frames failed");
+  }
+  for (const auto& item : *batch) {
+    if (!item.get()->ensureVerified() || item->pos()->z() != 3.0f) {
+      throw std::runtime_error("deferred verification of a FinishSizePrefixed batch item must pass");
+    }
+  }
+
+  v_int64 sinkHp = 0;
+  ofb::FrameSink<MyGame::Example::Monster> sink(mapper,
+      [&](const ofb::Object<MyGame::Example::Monster>& frame) {
+        sinkHp += frame->pos() ? frame->hp() : 0;
+        return true;
+      });
+  oatpp::async::Action action;
+  if (sink.write(body->data(), static_cast<v_buff_size>(body->size()), action) != static_cast<v_io_size>(body->size()) ||
+      sink.getFrameCount() != 2 || sinkHp != 33) {
+    throw std::runtime_error("frame sink must accept FinishSizePrefixed frames");
+  }
+
+  v_int64 readerHp = 0;
+  bool failed = false;
+  runFrameReader(std::make_shared<oatpp::data::stream::BufferInputStream>(body), mapper,
+                 static_cast<v_int64>(body->size()), readerHp, failed);
+  if (failed || readerHp != 33) {
+    throw std::runtime_error("frame reader must accept FinishSizePrefixed frames");
+  }
+}
+
+// 在根偏移之后插入 4 字节：内部相对偏移不变，但所有表与 struct 相对 builder 的对齐基准错开 4 字节，
+// Monster.pos（Vec3，含 double）落到 4 mod 8 的偏移上。rootAt 为根偏移所在位置（size-prefixed 时为 4）
+static std::string misalignBody(const std::string& buffer, size_t rootAt) {
+  std::string out(buffer, 0, rootAt);
+  if (rootAt == 4) {
+    flatbuffers::WriteScalar<flatbuffers::uoffset_t>(&out[0], static_cast<flatbuffers::uoffset_t>(buffer.size()));
+  }
+  std::string root(4, '\0');
+  flatbuffers::WriteScalar<flatbuffers::uoffset_t>(&root[0],
+      flatbuffers::ReadScalar<flatbuffers::uoffset_t>(buffer.data() + rootAt) + 4);
+  out += root;
+  out += std::string(4, '\0');
+  out.append(buffer, rootAt + 4, std::string::npos);
+  return out;
+}
+
+static void test_verify_rejects_misaligned_structs() {
+  std::string prefixed = buildSizePrefixedMonsterWithPos(7);
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto name = builder.CreateString("P");
+  MyGame::Example::Vec3 pos(1.0f, 2.0f, 3.0f, 4.0, MyGame::Example::Color_Green, MyGame::Example::Test(5, 6));
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_pos(&pos);
+  MyGame::Example::FinishMonsterBuffer(builder, mb.Finish());
+  std::string plain(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+
+  auto readOne = [](const std::shared_ptr<ofb::ObjectMapper>& mapper, const std::string& bytes) {
+    oatpp::String body(bytes);
+    oatpp::utils::parser::Caret caret(body);
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = mapper->read(caret, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack);
+    return value && errorStack.empty();
+  };
+  ofb::ObjectMapper::Config prefixedConfig;
+  prefixedConfig.sizePrefixed = true;
+  auto prefixedMapper = std::make_shared<ofb::ObjectMapper>(prefixedConfig);
+  auto plainMapper = std::make_shared<ofb::ObjectMapper>();
+
+  if (!readOne(plainMapper, plain) || !readOne(prefixedMapper, prefixed)) {
+    throw std::runtime_error("well-aligned buffers must verify");
+  }
+  if (readOne(plainMapper, misalignBody(plain, 0))) {
+    throw std::runtime_error("a buffer with a misaligned Vec3 must fail verification");
+  }
+  if (readOne(prefixedMapper, misalignBody(prefixed, 4))) {
+    throw std::runtime_error("a size-prefixed frame with a misaligned Vec3 must fail verification");
+  }
+
+  // 延迟校验（批量项）同样从前缀起检查对齐
+  std::string bad = misalignBody(prefixed, 4);
+  oatpp::String batchBody(prefixed + bad);
+  oatpp::utils::parser::Caret batchCaret(batchBody);
+  auto batch = plainMapper->readFromCaret<oatpp::List<ofb::Object<MyGame::Example::Monster>>>(batchCaret);
+  if (!batch || batch->size() != 2) {
+    throw std::runtime_error("batch framing of misaligned items must still succeed");
+  }
+  auto it = batch->begin();
+  if (!(*it).get()->ensureVerified()) {
+    throw std::runtime_error("aligned batch item must verify");
+  }
+  ++it;
+  if ((*it).get()->ensureVerified() || (*it).compacted().get()->ensureVerified()) {
+    throw std::runtime_error("misaligned batch item must fail deferred verification, also after compaction");
+  }
+}
+
+// 工厂返回空对象时：不前移 Caret，并给出错误
+static void test_read_factory_failure_keeps_caret() {
+  static const oatpp::data::type::ClassId classId("test::NullFlatBuffersObject");
+  static oatpp::data::type::Type* type = []() {
+    oatpp::data::type::Type::Info info;
+    info.parent = ofb::AbstractFlatBuffersObject::Class::getType();
+    auto* t = new oatpp::data::type::Type(classId, info);
+    ofb::FlatBuffersTypeRegistry::instance().registerFactory(t, [](const ofb::FlatBuffersBufferSource&) -> oatpp::Void {
+      return nullptr;
+    });
+    return t;
+  }();
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  auto raw = buildMinimalMonster();
+  oatpp::String body(reinterpret_cast<const char*>(raw->data()), static_cast<v_buff_size>(raw->size()));
+  oatpp::utils::parser::Caret caret(body);
+  oatpp::data::mapping::ErrorStack errorStack;
+  auto value = mapper->read(caret, type, errorStack);
+  if (value || errorStack.empty() || caret.getPosition() != 0) {
+    throw std::runtime_error("a failed factory must report an error and leave the caret in place");
+  }
+}
+
+// 每次 read 最多给出 chunk 字节，模拟 socket 上被任意切开的 body；记录实际被读走的字节数
+class TrickleInputStream : public oatpp::data::stream::InputStream {
+private:
+  std::shared_ptr<oatpp::data::stream::BufferInputStream> m_inner;
+  v_buff_size m_chunk;
+  v_int64 m_consumed = 0;
+public:
+  TrickleInputStream(const oatpp::String& data, v_buff_size chunk)
+    : m_inner(std::make_shared<oatpp::data::stream::BufferInputStream>(data)), m_chunk(chunk) {}
+
+  v_io_size read(void* buffer, v_buff_size count, oatpp::async::Action& action) override {
+    auto res = m_inner->read(buffer, std::min(count, m_chunk), action);
+    if (res > 0) m_consumed += res;
+    return res;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    m_inner->setInputStreamIOMode(ioMode);
+  }
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override {
+    return m_inner->getInputStreamIOMode();
+  }
+
+  oatpp::data::stream::Context& getInputStreamContext() override {
+    return m_inner->getInputStreamContext();
+  }
+
+  v_int64 getConsumed() const {
+    return m_consumed;
+  }
+};
+
+static void test_frame_reader_split_reads_and_content_length() {
+  std::string first = buildSizePrefixedMonsterWithPos(11);
+  std::string second = buildSizePrefixedMonsterWithPos(22);
+  std::string trailing = buildSizePrefixedMonsterWithPos(44);
+  oatpp::String body(first + second + trailing);
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+
+  // 前缀与帧都被切成 3 字节一块；contentLength 之后属于"下一个请求"，不能被读走
+  v_int64 bounded = static_cast<v_int64>(first.size() + second.size());
+  auto stream = std::make_shared<TrickleInputStream>(body, 3);
+  v_int64 hp = 0;
+  bool failed = false;
+  runFrameReader(stream, mapper, bounded, hp, failed);
+  if (failed || hp != 33) {
+    throw std::runtime_error("frame reader must reassemble frames split across reads");
+  }
+  if (stream->getConsumed() != bounded) {
+    throw std::runtime_error("frame reader must not read past contentLength");
+  }
+
+  // contentLength 截断在第二帧中间：第一帧正常回调，随后报 Truncated frame，且仍不越界
+  v_int64 cut = static_cast<v_int64>(first.size() + 10);
+  auto truncated = std::make_shared<TrickleInputStream>(body, 5);
+  hp = 0;
+  failed = false;
+  runFrameReader(truncated, mapper, cut, hp, failed);
+  if (!failed || hp != 11 || truncated->getConsumed() != cut) {
+    throw std::runtime_error("frame reader must fail on a frame cut by contentLength");
+  }
+}
+
+static void test_read_any_object_by_file_identifier() {
+  ofb::FlatBuffersWrapper<MyGame::Example::Monster>::Class::setFileIdentifier(MyGame::Example::MonsterIdentifier());
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto name = builder.CreateString("Any");
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(99);
+  MyGame::Example::FinishMonsterBuffer(builder, mb.Finish());
+  oatpp::String body(reinterpret_cast<const char*>(builder.GetBufferPointer()),
+                     static_cast<v_buff_size>(builder.GetSize()));
+  oatpp::utils::parser::Caret caret(body);
+  auto any = mapper->readFromCaret<ofb::AnyObject>(caret);
+  if (!any || !any.is<MyGame::Example::Monster>()) {
+    throw std::runtime_error("file_identifier dispatch did not resolve Monster");
+  }
+  auto monster = any.as<MyGame::Example::Monster>();
+  if (!monster || monster->hp() != 99) {
+    throw std::runtime_error("AnyObject::as<Monster>() returned wrong object");
+  }
+  if (any.is<MyGame::Example::Stat>()) {
+    throw std::runtime_error("AnyObject must not report an unrelated type");
+  }
+}
+
+static void test_read_raw_caret_reuses_pooled_buffer() {
+  ofb::ObjectMapper::Config config;
+  config.inlineCopyThreshold = 0;
+  auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+  auto raw = buildMinimalMonster();
+  auto readOnce = [&]() {
+    oatpp::utils::parser::Caret caret(
+        reinterpret_cast<const char*>(raw->data()),
+        static_cast<v_buff_size>(raw->size()));
+    auto monster = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+    if (!monster || monster->hp() != 42) {
+      throw std::runtime_error("pooled copy path returned invalid monster");
+    }
+  };
+  readOnce();
+  auto before = ofb::BufferPool::instance().getStatistics();
+  readOnce();
+  auto after = ofb::BufferPool::instance().getStatistics();
+  if (after.hits != before.hits + 1) {
+    throw std::runtime_error("expected pooled buffer to be reused after object release");
+  }
+}
+
+static void test_from_bytes_single_allocation_copy() {
+  auto raw = buildMinimalMonster();
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw->data(), static_cast<v_buff_size>(raw->size()));
+  std::memset(raw->data(), 0, raw->size());
+  if (!monster || monster->hp() != 42 || monster.get()->getBufferSize() != static_cast<v_buff_size>(raw->size())) {
+    throw std::runtime_error("fromBytes must own an independent copy");
+  }
+  if (reinterpret_cast<uintptr_t>(monster.get()->getBufferData()) % 16 != 0) {
+    throw std::runtime_error("inline storage must be 16-byte aligned");
+  }
+  if (!monster.getMutable()) {
+    throw std::runtime_error("inline storage is owned and must be mutable");
+  }
+}
+
+static void test_from_builder_adopts_memory() {
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto name = builder.CreateString("B");
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(7);
+  builder.Finish(mb.Finish());
+  const uint8_t* builderData = builder.GetBufferPointer();
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBuilder(std::move(builder));
+  if (!monster || monster->hp() != 7 || monster.get()->getBufferData() != builderData) {
+    throw std::runtime_error("fromBuilder must adopt the builder memory without copying");
+  }
+  if (!monster.getMutable() || !monster.getMutable()->mutate_hp(8) || monster->hp() != 8) {
+    throw std::runtime_error("builder-owned buffer must be mutable");
+  }
+}
+
+static void test_pooled_builder_returns_to_pool() {
+  ofb::ObjectMapper mapper;
+  flatbuffers::FlatBufferBuilder* first = nullptr;
+  {
+    auto builder = mapper.acquireBuilder();
+    first = builder.get();
+    auto name = builder->CreateString("P");
+    MyGame::Example::MonsterBuilder mb(*builder);
+    mb.add_name(name);
+    mb.add_hp(9);
+    builder->Finish(mb.Finish());
+    const uint8_t* builderData = builder->GetBufferPointer();
+    auto monster = ofb::Object<MyGame::Example::Monster>::fromPooledBuilder(std::move(builder));
+    if (!monster || monster->hp() != 9 || monster.get()->getBufferData() != builderData) {
+      throw std::runtime_error("fromPooledBuilder must wrap the builder output without copying");
+    }
+  }
+  auto before = ofb::BuilderPool::instance().getStatistics();
+  auto again = mapper.acquireBuilder();
+  auto after = ofb::BuilderPool::instance().getStatistics();
+  if (again.get() != first || after.hits != before.hits + 1 || again->GetSize() != 0) {
+    throw std::runtime_error("released builder must be cleared and reused on the same thread");
+  }
+}
+
+static void test_builder_pool_discards_oversized_builders() {
+  auto before = ofb::BuilderPool::instance().getStatistics();
+  {
+    auto builder = ofb::BuilderPool::instance().acquire();
+    std::vector<uint8_t> blob(static_cast<size_t>(ofb::BuilderPool::MAX_RETAINED_CAPACITY) + 1, 0x5A);
+    builder->Finish(builder->CreateVector(blob));
+    if (static_cast<v_buff_size>(builder->GetBufferCapacity()) <= ofb::BuilderPool::MAX_RETAINED_CAPACITY) {
+      throw std::runtime_error("builder should have grown past the retained capacity");
+    }
+  }
+  auto after = ofb::BuilderPool::instance().getStatistics();
+  if (after.discarded != before.discarded + 1 || after.recycled != before.recycled) {
+    throw std::runtime_error("a builder above MAX_RETAINED_CAPACITY must not be cached");
+  }
+}
+
+static void test_arena_backs_builder_and_read_copy() {
+  auto arena = ofb::Arena::createShared();
+  std::weak_ptr<ofb::Arena> weak = arena;
+  ofb::Object<MyGame::Example::Monster> built;
+  ofb::Object<MyGame::Example::Monster> read;
+  {
+    flatbuffers::FlatBufferBuilder builder(256, arena->getFlatBuffersAllocator());
+    auto name = builder.CreateString("A");
+    MyGame::Example::MonsterBuilder mb(builder);
+    mb.add_name(name);
+    mb.add_hp(11);
+    builder.Finish(mb.Finish());
+    built = ofb::Object<MyGame::Example::Monster>::fromArenaBuilder(arena, builder);
+  }
+  if (!built || built->hp() != 11) {
+    throw std::runtime_error("fromArenaBuilder must wrap the arena-backed builder output");
+  }
+  auto before = arena->getUsedBytes();
+  {
+    auto buf = buildMinimalMonster();
+    ofb::ObjectMapper mapper;
+    oatpp::utils::parser::Caret caret(
+        reinterpret_cast<const char*>(buf->data()),
+        static_cast<v_buff_size>(buf->size()));
+    oatpp::data::mapping::ErrorStack errorStack;
+    read = mapper.read(caret, ofb::Object<MyGame::Example::Monster>::Class::getType(), arena, errorStack)
+      .cast<ofb::Object<MyGame::Example::Monster>>();
+    if (!errorStack.empty() || !read || read->hp() != 42) {
+      throw std::runtime_error("read with an explicit arena must succeed");
+    }
+  }
+  if (arena->getUsedBytes() <= before) {
+    throw std::runtime_error("read copy must come from the given arena");
+  }
+  arena.reset();
+  built = nullptr;
+  if (weak.expired()) {
+    throw std::runtime_error("arena must stay alive while an object references it");
+  }
+  read = nullptr;
+  if (!weak.expired()) {
+    throw std::runtime_error("arena must be freed with the last object");
+  }
+}
+
+static void test_read_misaligned_borrow_falls_back_to_aligned_copy() {
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  auto raw = buildMinimalMonster();
+  std::string bytes(1, '\0');
+  bytes.append(reinterpret_cast<const char*>(raw->data()), raw->size());
+  oatpp::String body(bytes.data(), static_cast<v_buff_size>(bytes.size()));
+  oatpp::utils::parser::Caret caret(body);
+  caret.setPosition(1);
+  auto monster = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  if (!monster || monster->hp() != 42) {
+    throw std::runtime_error("misaligned borrowed region must still be readable");
+  }
+  auto end = reinterpret_cast<uintptr_t>(monster.get()->getBufferData() + monster.get()->getBufferSize());
+  if (monster.get()->getBufferData() == reinterpret_cast<const uint8_t*>(body->data()) + 1 || (end & 3) != 0) {
+    throw std::runtime_error("misaligned borrowed region must be copied into aligned storage");
+  }
+}
+
+static void test_read_from_buffer_borrows_owned_storage() {
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  auto raw = buildMinimalMonster();
+  auto pooled = ofb::BufferPool::instance().acquire(static_cast<v_buff_size>(raw->size()));
+  pooled->assign(raw->begin(), raw->end());
+  oatpp::data::mapping::ErrorStack errorStack;
+  auto monster = mapper->readFromBuffer(pooled, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack)
+      .cast<ofb::Object<MyGame::Example::Monster>>();
+  if (!errorStack.empty() || !monster || monster->hp() != 42) {
+    throw std::runtime_error("readFromBuffer failed");
+  }
+  if (monster.get()->getBufferData() != pooled->data()) {
+    throw std::runtime_error("readFromBuffer must borrow the aligned buffer without copying");
+  }
+}
+
+static void test_retention_policy_and_pinned_bytes() {
+  std::string bytes = buildSizePrefixedMonster("R", 80);
+  bytes.append(4096, '\0');
+  oatpp::String body(bytes.data(), static_cast<v_buff_size>(bytes.size()));
+
+  ofb::ObjectMapper::Config config;
+  config.sizePrefixed = true;
+  auto pinnedBefore = ofb::AbstractFlatBuffersObject::getPinnedBytes();
+  {
+    auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+    oatpp::utils::parser::Caret caret(body);
+    auto borrowed = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+    if (!borrowed || !borrowed.get()->isBorrowed()) {
+      throw std::runtime_error("without a retention policy the region must be borrowed");
+    }
+    if (ofb::AbstractFlatBuffersObject::getPinnedBytes() != pinnedBefore + static_cast<v_int64>(body->size())) {
+      throw std::runtime_error("borrowed object must count the whole body as pinned");
+    }
+    auto compacted = borrowed.compacted();
+    borrowed = nullptr;
+    if (!compacted || compacted.get()->isBorrowed() || compacted->hp() != 80) {
+      throw std::runtime_error("compacted() must return an owned copy");
+    }
+    if (ofb::AbstractFlatBuffersObject::getPinnedBytes() != pinnedBefore) {
+      throw std::runtime_error("pinned bytes must drop once the borrowed object is released");
+    }
+  }
+
+  config.compactRatio = 8;
+  auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+  oatpp::utils::parser::Caret caret(body);
+  auto monster = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  if (!monster || monster.get()->isBorrowed() || monster->hp() != 80) {
+    throw std::runtime_error("small region of a large body must be compacted at read time");
+  }
+  if (ofb::AbstractFlatBuffersObject::getPinnedBytes() != pinnedBefore) {
+    throw std::runtime_error("compacted object must not pin the body");
+  }
+}
+
+static void test_json_transcoding_round_trip() {
+  auto transcoder = ofb::JsonTranscodingMapper::createShared(
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  transcoder->bindRootType<MyGame::Example::Monster>("MyGame.Example.Monster");
+  auto monster = transcoder->readFromString<ofb::Object<MyGame::Example::Monster>>(
+      oatpp::String("{\"name\":\"J\",\"hp\":33,\"inventory\":[1,2,3]}"));
+  if (!monster || !monster->name() || monster->name()->str() != "J" || monster->hp() != 33 ||
+      !monster->inventory() || monster->inventory()->size() != 3) {
+    throw std::runtime_error("JSON body must transcode into Object<Monster>");
+  }
+  auto json = transcoder->writeToString(monster);
+  auto again = transcoder->readFromString<ofb::Object<MyGame::Example::Monster>>(json);
+  if (!again || again->hp() != 33 || json->find("\"hp\":33") == std::string::npos) {
+    throw std::runtime_error("Object<Monster> must transcode back to JSON");
+  }
+  oatpp::data::mapping::ErrorStack errorStack;
+  oatpp::String schemaText("table Injected {}");
+  oatpp::utils::parser::Caret caret(schemaText);
+  auto rejected = transcoder->read(caret, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack);
+  if (rejected || errorStack.empty()) {
+    throw std::runtime_error("schema text must be rejected as a JSON body");
+  }
+}
+
+static void test_schema_cache_field_paths() {
+  auto schema = ofb::SchemaCache::instance().load(
+      "monster_test.bfbs",
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  if (!schema || !schema->getRootObject() || schema->getRootObject()->name != "MyGame.Example.Monster") {
+    throw std::runtime_error("schema cache must compile monster_test.bfbs");
+  }
+  if (ofb::SchemaCache::instance().get("monster_test.bfbs") != schema) {
+    throw std::runtime_error("schema cache must return the cached schema");
+  }
+
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto enemyName = builder.CreateString("E");
+  MyGame::Example::Vec3 enemyPos(1.5f, 2.5f, 3.5f, 4.0, MyGame::Example::Color_Green, MyGame::Example::Test(9, 1));
+  MyGame::Example::MonsterBuilder eb(builder);
+  eb.add_name(enemyName);
+  eb.add_pos(&enemyPos);
+  auto enemy = eb.Finish();
+  auto name = builder.CreateString("S");
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_enemy(enemy);
+  builder.Finish(mb.Finish());
+  auto buffer = builder.GetBufferPointer();
+
+  auto x = ofb::FieldPath::compile(schema, nullptr, "enemy.pos.x");
+  auto a = ofb::FieldPath::compile(schema, nullptr, "enemy.pos.test3.a");
+  auto hp = ofb::FieldPath::compile(schema, nullptr, "hp");
+  auto enemyNamePath = ofb::FieldPath::compile(schema, nullptr, "enemy.name");
+  auto missing = ofb::FieldPath::compile(schema, nullptr, "pos.x");
+  if (!x.isValid() || !a.isValid() || !hp.isValid() || !enemyNamePath.isValid() || !missing.isValid()) {
+    throw std::runtime_error("field paths must compile against the schema");
+  }
+  if (ofb::FieldPath::compile(schema, nullptr, "enemy.nope").isValid() ||
+      ofb::FieldPath::compile(schema, nullptr, "name.x").isValid()) {
+    throw std::runtime_error("unknown or non-object path segments must not compile");
+  }
+  if (x.getReal(buffer) != 1.5 || a.getInteger(buffer) != 9 || hp.getInteger(buffer) != 100) {
+    throw std::runtime_error("field paths must resolve scalars and schema defaults");
+  }
+  auto resolvedName = enemyNamePath.getString(buffer);
+  if (!resolvedName || resolvedName->str() != "E") {
+    throw std::runtime_error("field path must resolve string leaves");
+  }
+  if (missing.resolve(buffer) != nullptr || missing.getReal(buffer) != 0) {
+    throw std::runtime_error("absent struct on the path must resolve to the default");
+  }
+}
+
+static void test_projection_keeps_only_requested_fields() {
+  auto schema = ofb::CompiledSchema::compile(
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  auto projector = ofb::Projector::createShared(schema);
+
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto enemyName = builder.CreateString("E");
+  MyGame::Example::MonsterBuilder eb(builder);
+  eb.add_name(enemyName);
+  auto enemy = eb.Finish();
+  std::vector<uint8_t> inv(512, 7);
+  auto inventory = builder.CreateVector(inv);
+  std::vector<MyGame::Example::Test> tests = {MyGame::Example::Test(1, 2), MyGame::Example::Test(3, 4)};
+  auto test4 = builder.CreateVectorOfStructs(tests);
+  auto name = builder.CreateString("P");
+  MyGame::Example::Vec3 pos(1.0f, 2.0f, 3.0f, 4.0, MyGame::Example::Color_Blue, MyGame::Example::Test(5, 6));
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(55);
+  mb.add_pos(&pos);
+  mb.add_inventory(inventory);
+  mb.add_test4(test4);
+  mb.add_enemy(enemy);
+  MyGame::Example::FinishMonsterBuffer(builder, mb.Finish());
+  auto source = ofb::Object<MyGame::Example::Monster>::fromBytes(builder.GetBufferPointer(), builder.GetSize());
+
+  auto projected = projector->project(source, oatpp::String(" hp , name,hp"));
+  if (!projected || projected->hp() != 55 || !projected->name() || projected->name()->str() != "P" ||
+      projected->inventory() || projected->enemy() || projected->pos()) {
+    throw std::runtime_error("projection must keep only the requested fields");
+  }
+  if (projected.getPtr()->getBufferSize() >= source.getPtr()->getBufferSize() / 4 ||
+      !MyGame::Example::MonsterBufferHasIdentifier(projected.getPtr()->getBufferData())) {
+    throw std::runtime_error("projection must shrink the buffer and keep the file identifier");
+  }
+  flatbuffers::Verifier verifier(projected.getPtr()->getBufferData(), static_cast<size_t>(projected.getPtr()->getBufferSize()));
+  if (!MyGame::Example::VerifyMonsterBuffer(verifier)) {
+    throw std::runtime_error("projected buffer must verify");
+  }
+
+  auto structOnly = projector->project(source, oatpp::String("pos,hp"));
+  if (!structOnly || !structOnly->pos() || structOnly->pos()->test3().a() != 5 || structOnly->hp() != 55 ||
+      !projector->getPlan(schema->getRootObject(), "hp,pos")->isInlineOnly()) {
+    throw std::runtime_error("struct-only projection must copy inline fields");
+  }
+  auto vectors = projector->project(source, oatpp::String("inventory,test4"));
+  if (!vectors || !vectors->inventory() || vectors->inventory()->size() != 512 || vectors->inventory()->Get(511) != 7 ||
+      !vectors->test4() || vectors->test4()->size() != 2 || vectors->test4()->Get(1)->a() != 3 ||
+      vectors->test4()->Get(1)->b() != 4 || vectors->name()) {
+    throw std::runtime_error("projection must copy vectors of scalars and structs");
+  }
+  flatbuffers::Verifier vectorVerifier(vectors.getPtr()->getBufferData(), static_cast<size_t>(vectors.getPtr()->getBufferSize()));
+  if (!MyGame::Example::VerifyMonsterBuffer(vectorVerifier)) {
+    throw std::runtime_error("projected vectors must verify");
+  }
+  auto nested = projector->project(source, oatpp::String("enemy"));
+  if (!nested || !nested->enemy() || nested->enemy()->name()->str() != "E" || nested->name()) {
+    throw std::runtime_error("projection must deep-copy selected sub-tables");
+  }
+  if (projector->getPlan(schema->getRootObject(), "name,hp") != projector->getPlan(schema->getRootObject(), "hp, name")) {
+    throw std::runtime_error("plans must be cached per normalized field set");
+  }
+  if (projector->project(source, oatpp::String("name,bogus"))) {
+    throw std::runtime_error("unknown fields must be rejected");
+  }
+}
+
+static void test_rpc_service_info_and_frame_stream() {
+  auto schema = ofb::SchemaCache::instance().load(
+      "monster_test.bfbs",
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  auto service = ofb::RpcServiceInfo::create(schema, "MyGame.Example.MonsterStorage", "/rpc");
+  if (!service || service->getCalls().size() != 4) {
+    throw std::runtime_error("rpc_service MonsterStorage must be reflected from the schema");
+  }
+  auto retrieve = service->findCall("Retrieve");
+  if (!retrieve || retrieve->streaming != ofb::RpcStreaming::SERVER || !retrieve->idempotent ||
+      retrieve->path != "/rpc/MyGame.Example.MonsterStorage/Retrieve" ||
+      !retrieve->request || retrieve->request->name != "MyGame.Example.Stat" ||
+      !retrieve->response || retrieve->response->name != "MyGame.Example.Monster") {
+    throw std::runtime_error("Retrieve must be a server-streaming Stat -> Monster call");
+  }
+  if (service->findCall("Store")->streaming != ofb::RpcStreaming::NONE ||
+      service->findCall("GetMaxHitPoint")->streaming != ofb::RpcStreaming::CLIENT ||
+      service->findCall("GetMinMaxHitPoints")->streaming != ofb::RpcStreaming::BIDI) {
+    throw std::runtime_error("streaming attributes must be reflected");
+  }
+
+  // 流式 body 逐帧拉取 -> 任意切分写入 FrameSink，还原出同样的对象序列
+  auto raw = buildMinimalMonster();
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw->data(), static_cast<v_buff_size>(raw->size()));
+  int produced = 0;
+  auto body = ofb::FlatBuffersStreamBody::createShared([&]() -> oatpp::Void {
+    if (produced == 3) return nullptr;
+    ++produced;
+    return monster;
+  });
+  std::vector<uint8_t> wire;
+  uint8_t chunk[7];
+  oatpp::async::Action action;
+  while (true) {
+    auto n = body->read(chunk, sizeof(chunk), action);
+    if (n <= 0) break;
+    wire.insert(wire.end(), chunk, chunk + n);
+  }
+  if (body->getKnownSize() != -1 || wire.size() != 3 * (raw->size() + 4)) {
+    throw std::runtime_error("stream body must write size-prefixed frames of unknown total size");
+  }
+  v_int64 hpSum = 0;
+  ofb::FrameSink<MyGame::Example::Monster> sink(std::make_shared<ofb::ObjectMapper>(),
+      [&](const ofb::Object<MyGame::Example::Monster>& frame) {
+        hpSum += frame->hp();
+        return true;
+      });
+  for (size_t offset = 0; offset < wire.size(); offset += 5) {
+    auto n = std::min<size_t>(5, wire.size() - offset);
+    if (sink.write(wire.data() + offset, static_cast<v_buff_size>(n), action) != static_cast<v_io_size>(n)) {
+      throw std::runtime_error("frame sink must accept arbitrarily split input");
+    }
+  }
+  if (sink.getFrameCount() != 3 || hpSum != 3 * 42 || !sink.isComplete()) {
+    throw std::runtime_error("frame sink must decode every frame");
+  }
+  sink.write(wire.data(), 6, action);
+  if (sink.isComplete()) {
+    throw std::runtime_error("a partial frame must leave the sink incomplete");
+  }
+}
+
+typedef ofb::BatchProcessor<MyGame::Example::Monster, v_int64> MonsterBatch;
+
+class MonsterBatchRunner : public oatpp::async::Coroutine<MonsterBatchRunner> {
+private:
+  std::shared_ptr<oatpp::async::Executor> m_executor;
+  oatpp::List<ofb::Object<MyGame::Example::Monster>> m_items;
+  std::shared_ptr<MonsterBatch::Results>* m_out;
+public:
+  MonsterBatchRunner(const std::shared_ptr<oatpp::async::Executor>& executor,
+                     const oatpp::List<ofb::Object<MyGame::Example::Monster>>& items,
+                     std::shared_ptr<MonsterBatch::Results>* out)
+    : m_executor(executor), m_items(items), m_out(out) {}
+
+  Action act() override {
+    return MonsterBatch::processAsync(m_executor, m_items,
+        [](const ofb::Object<MyGame::Example::Monster>& monster) -> v_int64 {
+          if (monster->hp() < 0) throw std::runtime_error("negative hp");
+          return monster->hp();
+        }, 4, 1).callbackTo(&MonsterBatchRunner::onDone);
+  }
+
+  Action onDone(const std::shared_ptr<MonsterBatch::Results>& results) {
+    *m_out = results;
+    return finish();
+  }
+};
+
+static void test_batch_read_and_parallel_process() {
+  // 批量 body：不管 config.sizePrefixed，逐帧读入同一 List，全部借用同一个 body
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  std::string body;
+  const int count = 9;
+  for (int i = 0; i < count; ++i) {
+    body += buildSizePrefixedMonster("B", static_cast<int16_t>(i == 5 ? -1 : 10 + i));
+  }
+  // 帧格式合法、内容非法的一项：读取时不拒绝，处理时单独失败
+  const uint8_t garbage[] = {8, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0x7F, 0x01, 0x02, 0x03, 0x04};
+  body.append(reinterpret_cast<const char*>(garbage), sizeof(garbage));
+  oatpp::String bodyString(body);
+  oatpp::utils::parser::Caret caret(bodyString);
+  auto batch = mapper->readFromCaret<oatpp::List<ofb::Object<MyGame::Example::Monster>>>(caret);
+  if (!batch || batch->size() != count + 1 || caret.canContinue()) {
+    throw std::runtime_error("batch read must split the body into every size-prefixed frame");
+  }
+  for (const auto& item : *batch) {
+    if (!item.get()->isBorrowed()) {
+      throw std::runtime_error("batch items must borrow the shared body");
+    }
+  }
+
+  auto executor = std::make_shared<oatpp::async::Executor>(2, 1, 1);
+  std::shared_ptr<MonsterBatch::Results> results;
+  executor->execute<MonsterBatchRunner>(executor, batch, &results);
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+  if (!results || results->size() != static_cast<size_t>(count + 1)) {
+    throw std::runtime_error("batch processor must return one result per item");
+  }
+  for (int i = 0; i < count; ++i) {
+    const auto& result = (*results)[static_cast<size_t>(i)];
+    bool expectOk = i != 5;
+    if (result.ok != expectOk || (expectOk && result.value != 10 + i)) {
+      throw std::runtime_error("batch results must keep input order and per-item status");
+    }
+  }
+  if ((*results)[count].ok || (*results)[count].error.empty()) {
+    throw std::runtime_error("invalid batch item must fail verification on its own");
+  }
+
+  std::string truncated = buildSizePrefixedMonster("T", 1);
+  truncated.resize(truncated.size() - 2);
+  oatpp::String truncatedString(buildSizePrefixedMonster("OK", 1) + truncated);
+  oatpp::utils::parser::Caret truncatedCaret(truncatedString);
+  oatpp::data::mapping::ErrorStack errorStack;
+  auto rejected = mapper->read(truncatedCaret, oatpp::List<ofb::Object<MyGame::Example::Monster>>::Class::getType(), errorStack);
+  if (rejected || errorStack.empty() || truncatedCaret.getPosition() != 0) {
+    throw std::runtime_error("a truncated frame must reject the whole batch");
+  }
+}
+
+static void test_flatbuffers_body_read_and_known_data() {
+  auto raw = buildMinimalMonster();
+  const auto size = static_cast<v_buff_size>(raw->size());
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw->data(), size);
+
+  // 普通模式：getKnownData() 直接指向对象的 buffer
+  ofb::FlatBuffersBody plain(monster);
+  if (static_cast<const void*>(plain.getKnownData()) != static_cast<const void*>(monster.get()->getBufferData()) ||
+      plain.getKnownSize() != static_cast<v_int64>(size)) {
+    throw std::runtime_error("plain body must expose the object buffer without copying");
+  }
+
+  // size-prefixed：没有 known data，按小块流式读出，前缀跨两次 read() 输出
+  ofb::FlatBuffersBody prefixed(monster, true);
+  if (prefixed.getKnownData() != nullptr || prefixed.getKnownSize() != static_cast<v_int64>(size) + 4) {
+    throw std::runtime_error("size-prefixed body must be streamed and count the prefix");
+  }
+  const v_buff_size counts[] = {3, 2, 1, 5};
+  std::vector<uint8_t> out;
+  uint8_t chunk[8];
+  oatpp::async::Action action;
+  for (size_t i = 0; ; ++i) {
+    if (i > static_cast<size_t>(size) + 4) {
+      throw std::runtime_error("size-prefixed body must reach EOF");
+    }
+    auto res = prefixed.read(chunk, counts[i % 4], action);
+    if (res == 0) break;
+    if (res < 0 || res > counts[i % 4] || !action.isNone()) {
+      throw std::runtime_error("read() must return at most count bytes synchronously");
+    }
+    out.insert(out.end(), chunk, chunk + res);
+  }
+  if (static_cast<v_buff_size>(out.size()) != size + 4 ||
+      flatbuffers::GetPrefixedSize(out.data()) != static_cast<flatbuffers::uoffset_t>(size) ||
+      !std::equal(raw->begin(), raw->end(), out.begin() + 4)) {
+    throw std::runtime_error("streamed body must be the size prefix followed by the buffer");
+  }
+  if (prefixed.read(chunk, sizeof(chunk), action) != 0) {
+    throw std::runtime_error("read() after the end must keep returning 0");
+  }
+}
+
+static std::shared_ptr<std::vector<uint8_t>> buildCompressibleMonster() {
+  flatbuffers::FlatBufferBuilder builder(4096);
+  std::vector<flatbuffers::Offset<flatbuffers::String>> strings;
+  std::vector<double> doubles;
+  for (int i = 0; i < 256; ++i) {
+    strings.push_back(builder.CreateString("item-" + std::to_string(i % 16)));
+    doubles.push_back(static_cast<double>(i % 8) * 0.5);
+  }
+  auto name = builder.CreateString("Z");
+  auto arrayOfString = builder.CreateVector(strings);
+  auto vectorOfDoubles = builder.CreateVector(doubles);
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(77);
+  mb.add_testarrayofstring(arrayOfString);
+  mb.add_vector_of_doubles(vectorOfDoubles);
+  builder.Finish(mb.Finish());
+  return std::make_shared<std::vector<uint8_t>>(
+      builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+static void test_content_encoding_round_trip() {
+  using Codec = ofb::ContentEncoding::Codec;
+  ofb::ContentEncoding::Config config;
+  if (ofb::ContentEncoding::negotiate(nullptr, config) != Codec::IDENTITY ||
+      ofb::ContentEncoding::negotiate("gzip;q=0, zstd;q=0, lz4;q=0", config) != Codec::IDENTITY ||
+      ofb::ContentEncoding::negotiate("*;q=0", config) != Codec::IDENTITY) {
+    throw std::runtime_error("rejected or missing encodings must negotiate identity");
+  }
+  Codec parsed;
+  if (!ofb::ContentEncoding::parse(" GZip ", parsed) || parsed != Codec::GZIP ||
+      ofb::ContentEncoding::parse("br", parsed)) {
+    throw std::runtime_error("Content-Encoding tokens must parse case-insensitively");
+  }
+
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  auto raw = buildCompressibleMonster();
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(raw->data(), static_cast<v_buff_size>(raw->size()));
+  bool anyCodec = false;
+  for (auto codec : {Codec::GZIP, Codec::ZSTD, Codec::LZ4}) {
+    if (!ofb::ContentEncoding::isAvailable(codec)) continue;
+    anyCodec = true;
+    auto encoded = ofb::ContentEncoding::encode(codec, raw->data(), static_cast<v_buff_size>(raw->size()));
+    if (!encoded || encoded->size() >= raw->size()) {
+      throw std::runtime_error(std::string("repetitive vectors must compress with ") + ofb::ContentEncoding::getName(codec));
+    }
+    auto decoded = ofb::ContentEncoding::decode(codec, encoded->data(), static_cast<v_buff_size>(encoded->size()), 1024 * 1024);
+    if (!decoded || *decoded != *raw || (reinterpret_cast<uintptr_t>(decoded->data()) & 15) != 0) {
+      throw std::runtime_error("decode must restore the buffer into aligned pooled storage");
+    }
+    oatpp::data::mapping::ErrorStack errorStack;
+    auto value = mapper->readFromBuffer(decoded, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack);
+    auto decodedMonster = value.cast<ofb::Object<MyGame::Example::Monster>>();
+    if (!decodedMonster || decodedMonster->hp() != 77 || decodedMonster->testarrayofstring()->size() != 256) {
+      throw std::runtime_error("decoded buffer must back the object directly");
+    }
+    if (ofb::ContentEncoding::decode(codec, encoded->data(), static_cast<v_buff_size>(encoded->size()) - 3, 1024 * 1024) ||
+        ofb::ContentEncoding::decode(codec, encoded->data(), static_cast<v_buff_size>(encoded->size()), 64)) {
+      throw std::runtime_error("truncated or oversized payloads must be rejected");
+    }
+
+    oatpp::String accept(std::string(ofb::ContentEncoding::getName(codec)) + ";q=0.9, identity;q=0.1");
+    auto body = ofb::FlatBuffersBody::createEncoded(monster, accept, config);
+    if (body->getContentEncoding() != codec || body->getKnownSize() != static_cast<v_int64>(encoded->size())) {
+      throw std::runtime_error("negotiated body must be compressed once with the accepted codec");
+    }
+  }
+
+  ofb::ContentEncoding::Config highThreshold;
+  highThreshold.minSize = 1024 * 1024;
+  auto smallBody = ofb::FlatBuffersBody::createEncoded(monster, "gzip, zstd, lz4", highThreshold);
+  if (smallBody->getContentEncoding() != Codec::IDENTITY || smallBody->getKnownSize() != static_cast<v_int64>(raw->size())) {
+    throw std::runtime_error("bodies below the threshold must be sent as is");
+  }
+  if (anyCodec == (ofb::ContentEncoding::negotiate("gzip, zstd, lz4", config) == Codec::IDENTITY)) {
+    throw std::runtime_error("an available codec must be chosen when offered");
+  }
+}
+
+static std::vector<uint8_t> buildSmallIdentifiedMonster(int i) {
+  static const char* NAMES[] = {"Orc", "Goblin", "Troll", "Dragon"};
+  flatbuffers::FlatBufferBuilder builder(256);
+  auto name = builder.CreateString(std::string(NAMES[i % 4]) + "-" + std::to_string(i % 50));
+  std::vector<uint8_t> inventory(static_cast<size_t>(i % 7), static_cast<uint8_t>(i % 3));
+  auto inventoryOffset = builder.CreateVector(inventory);
+  auto strings = builder.CreateVectorOfStrings({NAMES[(i + 1) % 4], NAMES[(i + 2) % 4]});
+  MyGame::Example::MonsterBuilder mb(builder);
+  mb.add_name(name);
+  mb.add_hp(static_cast<int16_t>(i % 300));
+  mb.add_mana(static_cast<int16_t>(i % 40));
+  mb.add_inventory(inventoryOffset);
+  mb.add_testarrayofstring(strings);
+  MyGame::Example::FinishMonsterBuffer(builder, mb.Finish());
+  return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+static void test_zstd_dictionary_small_messages() {
+  using Codec = ofb::ContentEncoding::Codec;
+  std::vector<std::vector<uint8_t>> samples;
+  for (int i = 0; i < 600; ++i) {
+    samples.push_back(buildSmallIdentifiedMonster(i));
+  }
+  auto content = ofb::ZstdDictionary::train(samples, 2048);
+  if (!ofb::ContentEncoding::isAvailable(Codec::ZSTD)) {
+    if (content || ofb::ZstdDictionary::create(MyGame::Example::MonsterIdentifier(), samples[0].data(), 8)) {
+      throw std::runtime_error("dictionaries must be unavailable without zstd");
+    }
+    return;
+  }
+  auto dictionary = content ? ofb::ZstdDictionaryRegistry::instance().load(
+      MyGame::Example::MonsterIdentifier(), content->data(), static_cast<v_buff_size>(content->size())) : nullptr;
+  if (!dictionary || dictionary->getId() == 0 ||
+      ofb::ZstdDictionaryRegistry::instance().findForBuffer(samples[0].data(), static_cast<v_buff_size>(samples[0].size())) != dictionary) {
+    throw std::runtime_error("trained dictionary must be registered under the Monster file_identifier");
+  }
+
+  auto message = buildSmallIdentifiedMonster(1234);
+  auto size = static_cast<v_buff_size>(message.size());
+  auto plain = ofb::ContentEncoding::encode(Codec::ZSTD, message.data(), size);
+  auto packed = dictionary->compress(message.data(), size);
+  if (!plain || !packed || packed->size() >= plain->size() ||
+      ofb::ZstdDictionary::getFrameDictionaryId(packed->data(), static_cast<v_buff_size>(packed->size())) != dictionary->getId()) {
+    throw std::runtime_error("a dictionary must shrink small messages below plain zstd");
+  }
+  auto restored = ofb::ContentEncoding::decode(Codec::ZSTD, packed->data(), static_cast<v_buff_size>(packed->size()), 4096);
+  if (!restored || *restored != message) {
+    throw std::runtime_error("decode must pick the dictionary from the frame dictID");
+  }
+
+  auto monster = ofb::Object<MyGame::Example::Monster>::fromBytes(message.data(), size);
+  auto body = ofb::FlatBuffersBody::createEncoded(monster, "zstd");
+  if (body->getContentEncoding() != Codec::ZSTD || body->getKnownSize() != static_cast<v_int64>(packed->size())) {
+    throw std::runtime_error("small bodies with a registered dictionary must be compressed with it");
+  }
+}
+
+static void test_mapper_metrics_and_prometheus_text() {
+  using Metrics = ofb::MapperMetrics;
+  const std::string monsterName = "MyGame::Example::Monster";
+  auto counter = [&monsterName](const Metrics::Snapshot& snapshot, Metrics::Counter c) -> v_int64 {
+    auto stats = snapshot.find(monsterName);
+    return stats ? stats->get(c) : 0;
+  };
+  auto before = Metrics::instance().snapshot();
+
+  auto mapper = std::make_shared<ofb::ObjectMapper>();
+  auto raw = buildMinimalMonster();
+  auto size = static_cast<v_buff_size>(raw->size());
+  oatpp::String body(reinterpret_cast<const char*>(raw->data()), size);
+  std::vector<uint8_t> garbage = {0xFF, 0xFF, 0xFF, 0x7F, 0x01, 0x02, 0x03, 0x04};
+  oatpp::String badBody(reinterpret_cast<const char*>(garbage.data()), static_cast<v_buff_size>(garbage.size()));
+
+  // 其他线程上的读取：线程退出后计数并入累计值
+  std::thread worker([&]() {
+    oatpp::utils::parser::Caret caret(body);
+    mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(caret);
+  });
+  worker.join();
+
+  oatpp::utils::parser::Caret borrowCaret(body);
+  auto borrowed = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(borrowCaret);
+  oatpp::utils::parser::Caret copyCaret(reinterpret_cast<const char*>(raw->data()), size);
+  auto copied = mapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(copyCaret);
+  oatpp::utils::parser::Caret badCaret(badBody);
+  oatpp::data::mapping::ErrorStack errorStack;
+  auto bad = mapper->read(badCaret, ofb::Object<MyGame::Example::Monster>::Class::getType(), errorStack);
+  auto written = mapper->writeToString(borrowed);
+  if (!borrowed || !copied || bad || !written) {
+    throw std::runtime_error("metrics test setup failed");
+  }
+
+  auto after = Metrics::instance().snapshot();
+  if (counter(after, Metrics::READS_BORROWED) - counter(before, Metrics::READS_BORROWED) != 2 ||
+      counter(after, Metrics::READS_COPIED) - counter(before, Metrics::READS_COPIED) != 1 ||
+      counter(after, Metrics::READ_BYTES) - counter(before, Metrics::READ_BYTES) != 3 * size) {
+    throw std::runtime_error("reads must be counted per type, split into borrow and copy, across threads");
+  }
+  if (counter(after, Metrics::READ_ERRORS) - counter(before, Metrics::READ_ERRORS) != 1 ||
+      counter(after, Metrics::VERIFICATIONS) - counter(before, Metrics::VERIFICATIONS) != 4 ||
+      counter(after, Metrics::VERIFY_FAILURES) - counter(before, Metrics::VERIFY_FAILURES) != 1) {
+    throw std::runtime_error("failed bodies and verifications must be counted");
+  }
+  if (counter(after, Metrics::WRITES) - counter(before, Metrics::WRITES) != 1 ||
+      counter(after, Metrics::WRITE_BYTES) - counter(before, Metrics::WRITE_BYTES) != size) {
+    throw std::runtime_error("writes must be counted with their size");
+  }
+
+  ofb::ObjectMapper::Config quiet;
+  quiet.collectMetrics = false;
+  auto quietMapper = std::make_shared<ofb::ObjectMapper>(quiet);
+  oatpp::utils::parser::Caret quietCaret(body);
+  quietMapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(quietCaret);
+  if (counter(Metrics::instance().snapshot(), Metrics::READS_BORROWED) != counter(after, Metrics::READS_BORROWED)) {
+    throw std::runtime_error("collectMetrics = false must not record reads");
+  }
+  quiet.lazyVerify = true;
+  auto quietLazyMapper = std::make_shared<ofb::ObjectMapper>(quiet);
+  oatpp::utils::parser::Caret quietLazyCaret(body);
+  auto quietLazy = quietLazyMapper->readFromCaret<ofb::Object<MyGame::Example::Monster>>(quietLazyCaret);
+  if (!quietLazy || !quietLazy.get()->ensureVerified() ||
+      counter(Metrics::instance().snapshot(), Metrics::VERIFICATIONS) != counter(after, Metrics::VERIFICATIONS)) {
+    throw std::runtime_error("collectMetrics = false must not record deferred verification");
+  }
+
+  auto text = Metrics::toPrometheusText(after);
+  if (text.find("# TYPE oatpp_flatbuffers_read_size_bytes histogram") == std::string::npos ||
+      text.find("oatpp_flatbuffers_reads_total{type=\"MyGame::Example::Monster\",mode=\"borrow\"}") == std::string::npos ||
+      text.find("oatpp_flatbuffers_read_size_bytes_bucket{type=\"MyGame::Example::Monster\",le=\"+Inf\"}") == std::string::npos) {
+    throw std::runtime_error("Prometheus text must expose per-type counters and histograms");
+  }
+}
+
+#ifdef OATPP_FLATBUFFERS_WITH_WEBSOCKET
+
+// 记录 AsyncWebSocket 写出的字节（close 帧），读端始终为空
+class CapturingIOStream : public oatpp::data::stream::IOStream {
+public:
+  std::string written;
+public:
+  oatpp::v_io_size write(const void* data, v_buff_size count, oatpp::async::Action& action) override {
+    (void) action;
+    written.append(static_cast<const char*>(data), static_cast<size_t>(count));
+    return count;
+  }
+  oatpp::v_io_size read(void* buffer, v_buff_size count, oatpp::async::Action& action) override {
+    (void) buffer;
+    (void) count;
+    (void) action;
+    return 0;
+  }
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override { (void) ioMode; }
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override { return oatpp::data::stream::IOMode::ASYNCHRONOUS; }
+  oatpp::data::stream::Context& getOutputStreamContext() override { return context(); }
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override { (void) ioMode; }
+  oatpp::data::stream::IOMode getInputStreamIOMode() override { return oatpp::data::stream::IOMode::ASYNCHRONOUS; }
+  oatpp::data::stream::Context& getInputStreamContext() override { return context(); }
+private:
+  static oatpp::data::stream::Context& context() {
+    static oatpp::data::stream::DefaultInitializedContext ctx(oatpp::data::stream::StreamType::STREAM_INFINITE);
+    return ctx;
+  }
+};
+
+// 在执行器中跑完 `make()` 返回的协程链（监听器的回调与 close 帧都在链上）
+class StarterRunner : public oatpp::async::Coroutine<StarterRunner> {
+private:
+  std::function<oatpp::async::CoroutineStarter()> m_make;
+public:
+  explicit StarterRunner(const std::function<oatpp::async::CoroutineStarter()>& make)
+    : m_make(make) {}
+
+  Action act() override {
+    return m_make().next(finish());
+  }
+};
+
+static void runStarter(const std::function<oatpp::async::CoroutineStarter()>& make) {
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  executor->execute<StarterRunner>(make);
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+}
+
+typedef ofb::WebSocketFrameListener<MyGame::Example::Monster> MonsterFrameListener;
+
+// 把一条消息按 chunkSize 切成多个分片喂给监听器（首片 BINARY，其后 CONTINUATION），最后以 size 0 结束消息
+static oatpp::async::CoroutineStarter feedFragmented(MonsterFrameListener& listener,
+                                                     const std::shared_ptr<oatpp::websocket::AsyncWebSocket>& socket,
+                                                     std::string message, size_t chunkSize) {
+  for (size_t offset = 0; offset < message.size(); offset += chunkSize) {
+    auto opcode = offset == 0 ? oatpp::websocket::Frame::OPCODE_BINARY : oatpp::websocket::Frame::OPCODE_CONTINUATION;
+    auto n = std::min(chunkSize, message.size() - offset);
+    auto starter = listener.readMessage(socket, opcode, reinterpret_cast<p_char8>(&message[offset]), static_cast<oatpp::v_io_size>(n));
+    if (starter) {
+      throw std::runtime_error("fragments must be buffered until the end of the message");
+    }
+  }
+  return listener.readMessage(socket, oatpp::websocket::Frame::OPCODE_CONTINUATION, nullptr, 0);
+}
+
+static v_uint16 closeCodeOf(const std::string& written) {
+  // 服务端不加掩码：0x88 | 长度 | 2 字节 close code（网络序）| 原因
+  if (written.size() < 4 || static_cast<uint8_t>(written[0]) != 0x88) {
+    return 0;
+  }
+  return static_cast<v_uint16>((static_cast<uint8_t>(written[2]) << 8) | static_cast<uint8_t>(written[3]));
+}
+
+static void test_websocket_listener_fragmented_messages() {
+  ofb::ObjectMapper::Config config;
+  config.sizePrefixed = true;
+  auto mapper = std::make_shared<ofb::ObjectMapper>(config);
+
+  std::vector<oatpp::Void> objects;
+  for (int16_t hp : {10, 20, 30}) {
+    flatbuffers::FlatBufferBuilder builder(256);
+    auto name = builder.CreateString("WS");
+    MyGame::Example::MonsterBuilder mb(builder);
+    mb.add_name(name);
+    mb.add_hp(hp);
+    builder.Finish(mb.Finish());
+    objects.push_back(ofb::Object<MyGame::Example::Monster>::fromBuilder(std::move(builder)));
+  }
+  auto payload = ofb::WebSocketFrameWriter::encodeCoalesced(objects);
+  v_buff_size expectedSize = 0;
+  for (const auto& object : objects) {
+    expectedSize += 4 + static_cast<const ofb::AbstractFlatBuffersObject*>(object.get())->getBufferSize();
+  }
+  if (static_cast<v_buff_size>(payload->size()) != expectedSize) {
+    throw std::runtime_error("coalesced payload must be the size-prefixed buffers back to back");
+  }
+
+  std::vector<int16_t> received;
+  auto callback = [&received](const std::shared_ptr<oatpp::websocket::AsyncWebSocket>&,
+                              const ofb::Object<MyGame::Example::Monster>& monster) -> oatpp::async::CoroutineStarter {
+    received.push_back(monster->hp());
+    return nullptr;
+  };
+
+  // 合并消息切成 5 字节的分片（前缀也被切开），消息结束后按序解出三个对象
+  {
+    auto stream = std::make_shared<CapturingIOStream>();
+    auto socket = oatpp::websocket::AsyncWebSocket::createShared(
+        oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(stream, nullptr), false);
+    MonsterFrameListener listener(mapper, callback);
+    runStarter([&]() { return feedFragmented(listener, socket, *payload, 5); });
+    if (received != std::vector<int16_t>({10, 20, 30}) || listener.getObjectCount() != 3 || !stream->written.empty()) {
+      throw std::runtime_error("fragmented coalesced message must decode every object in order");
+    }
+  }
+
+  // 超过 maxMessageSize：不回调，以 1009 关闭
+  received.clear();
+  {
+    auto stream = std::make_shared<CapturingIOStream>();
+    auto socket = oatpp::websocket::AsyncWebSocket::createShared(
+        oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(stream, nullptr), false);
+    MonsterFrameListener listener(mapper, callback, expectedSize - 1);
+    runStarter([&]() { return feedFragmented(listener, socket, *payload, 7); });
+    if (!received.empty() || closeCodeOf(stream->written) != MonsterFrameListener::CLOSE_CODE_TOO_BIG) {
+      throw std::runtime_error("oversized message must close with 1009");
+    }
+  }
+
+  // 第二帧的前缀越界：第一个对象照常回调，随后以 1007 关闭
+  received.clear();
+  {
+    auto stream = std::make_shared<CapturingIOStream>();
+    auto socket = oatpp::websocket::AsyncWebSocket::createShared(
+        oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(stream, nullptr), false);
+    MonsterFrameListener listener(mapper, callback);
+    auto first = static_cast<const ofb::AbstractFlatBuffersObject*>(objects[0].get());
+    std::string invalid = payload->substr(0, static_cast<size_t>(4 + first->getBufferSize()));
+    invalid.append("\xff\xff\xff\x7f" "garbage", 11);
+    runStarter([&]() { return feedFragmented(listener, socket, invalid, 3); });
+    if (received != std::vector<int16_t>({10}) || listener.getObjectCount() != 1 ||
+        closeCodeOf(stream->written) != MonsterFrameListener::CLOSE_CODE_INVALID_PAYLOAD) {
+      throw std::runtime_error("invalid frame must close with 1007 after the valid ones");
+    }
+  }
+}
+
+#endif
+
 int main() {
   test_read_with_caret_memory_handle();
   test_read_raw_caret_copies_underlying();
+  test_read_rejects_unverifiable_buffer();
+  test_read_lazy_verify_on_first_access();
+  test_read_verify_limits();
+  test_read_size_prefixed_consumes_one_frame();
+  test_size_prefixed_frames_with_aligned_structs();
+  test_frame_reader_split_reads_and_content_length();
+  test_verify_rejects_misaligned_structs();
+  test_read_factory_failure_keeps_caret();
+  test_read_any_object_by_file_identifier();
+  test_read_raw_caret_reuses_pooled_buffer();
+  test_from_bytes_single_allocation_copy();
+  test_from_builder_adopts_memory();
+  test_pooled_builder_returns_to_pool();
+  test_builder_pool_discards_oversized_builders();
+  test_arena_backs_builder_and_read_copy();
+  test_read_misaligned_borrow_falls_back_to_aligned_copy();
+  test_read_from_buffer_borrows_owned_storage();
+  test_retention_policy_and_pinned_bytes();
+  test_flatbuffers_body_read_and_known_data();
+  test_json_transcoding_round_trip();
+  test_schema_cache_field_paths();
+  test_projection_keeps_only_requested_fields();
+  test_rpc_service_info_and_frame_stream();
+  test_batch_read_and_parallel_process();
+  test_content_encoding_round_trip();
+  test_zstd_dictionary_small_messages();
+  test_mapper_metrics_and_prometheus_text();
+#ifdef OATPP_FLATBUFFERS_WITH_WEBSOCKET
+  test_websocket_listener_fragmented_messages();
+#endif
   return 0;
 }
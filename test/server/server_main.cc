@@ -1,5 +1,16 @@
 #include "oatpp-flatbuffers/ObjectMapper.hpp"
+#include "oatpp-flatbuffers/AlignedBodyReader.hpp"
+#include "oatpp-flatbuffers/BatchProcessor.hpp"
 #include "oatpp-flatbuffers/FlatBuffersWrapper.hpp"
+#include "oatpp-flatbuffers/FlatBuffersBody.hpp"
+#include "oatpp-flatbuffers/BuilderPool.hpp"
+#include "oatpp-flatbuffers/FrameReader.hpp"
+#include "oatpp-flatbuffers/FrameSink.hpp"
+#include "oatpp-flatbuffers/MetricsHandler.hpp"
+#include "oatpp-flatbuffers/Projection.hpp"
+#include "oatpp-flatbuffers/RequestBodyReader.hpp"
+#include "oatpp-flatbuffers/RpcService.hpp"
+#include "oatpp-flatbuffers/ZstdDictionary.hpp"
 #include "oatpp/web/server/api/ApiController.hpp"
 #include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
 #include "oatpp/web/server/HttpRouter.hpp"
@@ -9,11 +20,15 @@
 #include "oatpp/macro/codegen.hpp"
 #include "oatpp/Types.hpp"
 #include "monster_test_generated.h"
+#include "monster_test_bfbs_generated.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace ofb = oatpp::flatbuffers;
 
@@ -33,9 +48,11 @@ static std::string ReadAll(const std::string& path) {
 }
 
 // 辅助函数：创建一个示例 Monster 对象
-// 使用 FlatBuffersBuilder 创建一个简单的 Monster
-static std::shared_ptr<std::vector<uint8_t>> createSampleMonsterBuffer() {
-  flatbuffers::FlatBufferBuilder builder(1024);
+// 使用 FlatBuffersBuilder 创建一个简单的 Monster，并直接包装为 Object<Monster>
+static ofb::Object<MyGame::Example::Monster> createSampleMonster() {
+  // 从线程本地池取 builder，复用上次响应已分配的内部缓冲
+  auto pooled = ofb::BuilderPool::instance().acquire();
+  flatbuffers::FlatBufferBuilder& builder = *pooled;
   
   // 创建 Monster
   auto name = builder.CreateString("MyMonster");
@@ -62,23 +79,101 @@ static std::shared_ptr<std::vector<uint8_t>> createSampleMonsterBuffer() {
   
   builder.Finish(monster);
   
-  // 获取 buffer
-  auto buffer = std::make_shared<std::vector<uint8_t>>(
-      builder.GetBufferPointer(),
-      builder.GetBufferPointer() + builder.GetSize());
-  
-  return buffer;
+  // 零拷贝包装 builder 的输出，响应写完后 builder 回到池中
+  return ofb::Object<MyGame::Example::Monster>::fromPooledBuilder(std::move(pooled));
+}
+
+static std::shared_ptr<ofb::ObjectMapper> createFrameMapper() {
+  ofb::ObjectMapper::Config config;
+  config.sizePrefixed = true;
+  return std::make_shared<ofb::ObjectMapper>(config);
+}
+
+static std::shared_ptr<ofb::Projector> createProjector() {
+  auto schema = ofb::SchemaCache::instance().load(
+      "monster_test.bfbs",
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  return ofb::Projector::createShared(schema);
+}
+
+static ofb::Object<MyGame::Example::Stat> createStat(const char* id, int64_t val, uint16_t count) {
+  auto pooled = ofb::BuilderPool::instance().acquire();
+  pooled->Finish(MyGame::Example::CreateStat(*pooled, pooled->CreateString(id), val, count));
+  return ofb::Object<MyGame::Example::Stat>::fromPooledBuilder(std::move(pooled));
+}
+
+// 由 schema 中的 rpc_service MonsterStorage 生成路由：POST /rpc/MyGame.Example.MonsterStorage/<Call>
+static std::shared_ptr<ofb::RpcService> createMonsterStorage(const std::shared_ptr<ofb::ObjectMapper>& mapper) {
+  using MyGame::Example::Monster;
+  using MyGame::Example::Stat;
+  auto schema = ofb::SchemaCache::instance().load(
+      "monster_test.bfbs",
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  auto service = ofb::RpcService::createShared(schema, "MyGame.Example.MonsterStorage", mapper, "/rpc");
+
+  service->unary<Monster, Stat>("Store", [](const ofb::Object<Monster>& monster) {
+    return createStat(monster->name() ? monster->name()->c_str() : "", monster->hp(), 1);
+  });
+
+  // Stat.count 指定返回多少个 Monster；逐个生成，不缓存整个回复
+  service->serverStreaming<Stat, Monster>("Retrieve", [](const ofb::Object<Stat>& request) {
+    auto left = std::make_shared<uint16_t>(request->count());
+    return [left]() -> ofb::Object<Monster> {
+      if (*left == 0) return nullptr;
+      --*left;
+      return createSampleMonster();
+    };
+  });
+
+  service->clientStreaming<Monster, Stat>("GetMaxHitPoint", []() {
+    auto maxHp = std::make_shared<int64_t>(0);
+    auto count = std::make_shared<uint16_t>(0);
+    ofb::RpcClientStream<Monster, Stat> stream;
+    stream.onMessage = [maxHp, count](const ofb::Object<Monster>& monster) {
+      *maxHp = std::max<int64_t>(*maxHp, monster->hp());
+      ++*count;
+    };
+    stream.onComplete = [maxHp, count]() {
+      return createStat("max_hp", *maxHp, *count);
+    };
+    return stream;
+  });
+
+  return service;
 }
 
 class MonsterController : public oatpp::web::server::api::ApiController {
+private:
+  std::shared_ptr<ofb::ObjectMapper> m_frameMapper;
+  std::shared_ptr<ofb::Projector> m_projector;
+  std::shared_ptr<oatpp::async::Executor> m_executor;
 public:
   MonsterController(
-      const std::shared_ptr<oatpp::web::mime::ContentMappers>& contentMappers)
-      : oatpp::web::server::api::ApiController(contentMappers) {}
+      const std::shared_ptr<oatpp::web::mime::ContentMappers>& contentMappers,
+      const std::shared_ptr<oatpp::async::Executor>& executor)
+      : oatpp::web::server::api::ApiController(contentMappers)
+      , m_frameMapper(createFrameMapper())
+      , m_projector(createProjector())
+      , m_executor(executor) {}
+
+  const std::shared_ptr<ofb::ObjectMapper>& getFrameMapper() const {
+    return m_frameMapper;
+  }
+
+  const std::shared_ptr<ofb::Projector>& getProjector() const {
+    return m_projector;
+  }
+  
+  const std::shared_ptr<oatpp::async::Executor>& getExecutor() const {
+    return m_executor;
+  }
   
   static std::shared_ptr<MonsterController> createShared(
-      const std::shared_ptr<oatpp::web::mime::ContentMappers>& contentMappers) {
-    return std::make_shared<MonsterController>(contentMappers);
+      const std::shared_ptr<oatpp::web::mime::ContentMappers>& contentMappers,
+      const std::shared_ptr<oatpp::async::Executor>& executor) {
+    return std::make_shared<MonsterController>(contentMappers, executor);
   }
 
 #include OATPP_CODEGEN_BEGIN(ApiController)
@@ -88,10 +183,21 @@ public:
     
     Action act() override {
       try {
-        // 创建示例 Monster buffer 并包装为 Object<Monster>
-        auto buffer = createSampleMonsterBuffer();
-        auto monsterObj = ofb::Object<MyGame::Example::Monster>::fromBuffer(buffer);
-        return _return(controller->createDtoResponse(Status::CODE_200, monsterObj));
+        // 创建示例 Monster 并包装为 Object<Monster>
+        auto monsterObj = createSampleMonster();
+        // ?fields=name,hp 时只返回这些字段
+        auto fields = request->getQueryParameter("fields");
+        if (fields) {
+          monsterObj = controller->getProjector()->project(monsterObj, fields);
+          if (!monsterObj) {
+            return _return(controller->createResponse(Status::CODE_400, "Unknown field in 'fields'"));
+          }
+        }
+        // 直接从包装对象的 buffer 写出，省去 createDtoResponse 的序列化与二次拷贝；
+        // 按 Accept-Encoding 压缩（小于阈值的 body 原样返回）
+        return _return(OutgoingResponse::createShared(
+            Status::CODE_200, ofb::FlatBuffersBody::createEncoded(
+                monsterObj, request->getHeader(oatpp::web::protocol::http::Header::ACCEPT_ENCODING))));
       } catch (const std::exception& e) {
         return _return(controller->createResponse(
             Status::CODE_500, oatpp::String("Error: ") + e.what()));
@@ -101,11 +207,16 @@ public:
 
   ENDPOINT_ASYNC("POST", "/monster", PostMonster) {
     ENDPOINT_ASYNC_INIT(PostMonster)
+
+    // 请求 Arena：作为协程成员显式传给读取接口，跨越 yield 也安全；块按需申请，用不到时没有开销
+    std::shared_ptr<ofb::Arena> m_arena = ofb::Arena::createShared();
     
     Action act() override {
-      // 直接将请求体映射为 Object<Monster>
-      return request->readBodyToDtoAsync<ofb::Object<MyGame::Example::Monster>>(controller->getContentMappers()->getDefaultMapper())
-          .callbackTo(&PostMonster::onMonsterRead);
+      // 直接将请求体映射为 Object<Monster>；带 Content-Encoding 的 body 先透明解压，
+      // 需要拷贝时拷贝与包装对象落在 m_arena 中
+      return ofb::RequestBodyReader<MyGame::Example::Monster>::startForResult(
+          request, std::static_pointer_cast<ofb::ObjectMapper>(controller->getContentMappers()->getDefaultMapper()), m_arena)
+        .callbackTo(&PostMonster::onMonsterRead);
     }
     
     Action onMonsterRead(const ofb::Object<MyGame::Example::Monster>& monster) {
@@ -144,6 +255,125 @@ public:
     }
   };
 
+  // 压缩上传：Content-Encoding 为 gzip / zstd / lz4 时直接解压到对齐的池化缓冲，作为对象的存储
+  ENDPOINT_ASYNC("POST", "/monster/encoded", PostEncodedMonster) {
+    ENDPOINT_ASYNC_INIT(PostEncodedMonster)
+
+    v_int64 m_hp = 0;
+
+    Action act() override {
+      auto header = request->getHeader(oatpp::web::protocol::http::Header::CONTENT_LENGTH);
+      v_int64 contentLength = header ? std::strtoll(header->c_str(), nullptr, 10) : -1;
+      return ofb::AlignedBodyReader<MyGame::Example::Monster>::start(
+          request->getBodyStream(),
+          std::static_pointer_cast<ofb::ObjectMapper>(controller->getContentMappers()->getDefaultMapper()),
+          [this](const ofb::Object<MyGame::Example::Monster>& monster) -> oatpp::async::CoroutineStarter {
+            m_hp = monster->hp();
+            return nullptr;
+          },
+          contentLength,
+          16 * 1024 * 1024,
+          request->getHeader(oatpp::web::protocol::http::Header::CONTENT_ENCODING))
+        .next(yieldTo(&PostEncodedMonster::onDone));
+    }
+
+    Action onDone() {
+      return _return(controller->createResponse(
+          Status::CODE_200, oatpp::String("hp=" + std::to_string(m_hp))));
+    }
+  };
+
+  // 流式上传：body 为若干 size-prefixed Monster，逐帧解码，内存只受最大帧约束。
+  // 有 Content-Length 时由 FrameReader 直接拉取；chunked 等未知长度的 body 交给
+  // transferBodyToStreamAsync 解开传输编码后写入 FrameSink，不会读穿到下一个请求
+  ENDPOINT_ASYNC("POST", "/monsters/stream", PostMonsterStream) {
+    ENDPOINT_ASYNC_INIT(PostMonsterStream)
+
+    v_int64 m_count = 0;
+    v_int64 m_totalHp = 0;
+    std::shared_ptr<ofb::FrameSink<MyGame::Example::Monster>> m_sink;
+
+    Action act() override {
+      auto header = request->getHeader(oatpp::web::protocol::http::Header::CONTENT_LENGTH);
+      if (header) {
+        return ofb::FrameReader<MyGame::Example::Monster>::start(
+            request->getBodyStream(),
+            controller->getFrameMapper(),
+            [this](const ofb::Object<MyGame::Example::Monster>& monster) -> oatpp::async::CoroutineStarter {
+              ++m_count;
+              m_totalHp += monster->hp();
+              return nullptr;
+            },
+            std::strtoll(header->c_str(), nullptr, 10))
+          .next(yieldTo(&PostMonsterStream::onDone));
+      }
+      m_sink = std::make_shared<ofb::FrameSink<MyGame::Example::Monster>>(
+          controller->getFrameMapper(),
+          [this](const ofb::Object<MyGame::Example::Monster>& monster) {
+            ++m_count;
+            m_totalHp += monster->hp();
+            return true;
+          });
+      return request->transferBodyToStreamAsync(m_sink).next(yieldTo(&PostMonsterStream::onSinkDone));
+    }
+
+    Action onSinkDone() {
+      if (!m_sink->isComplete()) {
+        return _return(controller->createResponse(Status::CODE_400, "Truncated or invalid frame"));
+      }
+      return yieldTo(&PostMonsterStream::onDone);
+    }
+
+    Action onDone() {
+      return _return(controller->createResponse(
+          Status::CODE_200,
+          oatpp::String("frames=" + std::to_string(m_count) +
+                        ", hp=" + std::to_string(m_totalHp))));
+    }
+  };
+
+  // 批量上传：body 为若干 size-prefixed Monster，整体借用同一块 body，
+  // 校验与处理分块交给 Executor 的多个线程并行完成，逐项返回结果
+  ENDPOINT_ASYNC("POST", "/monsters/batch", PostMonsterBatch) {
+    ENDPOINT_ASYNC_INIT(PostMonsterBatch)
+
+    typedef ofb::BatchProcessor<MyGame::Example::Monster, v_int64> Batch;
+
+    Action act() override {
+      return request->readBodyToDtoAsync<oatpp::List<ofb::Object<MyGame::Example::Monster>>>(controller->getContentMappers()->getDefaultMapper())
+          .callbackTo(&PostMonsterBatch::onBatchRead);
+    }
+
+    Action onBatchRead(const oatpp::List<ofb::Object<MyGame::Example::Monster>>& monsters) {
+      if (!monsters) {
+        return _return(controller->createResponse(
+            Status::CODE_400, "Invalid FlatBuffers batch"));
+      }
+      return Batch::processAsync(controller->getExecutor(), monsters,
+          [](const ofb::Object<MyGame::Example::Monster>& monster) -> v_int64 {
+            return monster->hp();
+          })
+        .callbackTo(&PostMonsterBatch::onProcessed);
+    }
+
+    Action onProcessed(const std::shared_ptr<Batch::Results>& results) {
+      v_int64 failed = 0;
+      v_int64 totalHp = 0;
+      for (const auto& result : *results) {
+        if (result.ok) {
+          totalHp += result.value;
+        } else {
+          ++failed;
+        }
+      }
+      return _return(controller->createResponse(
+          Status::CODE_200,
+          oatpp::String("items=" + std::to_string(results->size()) +
+                        ", failed=" + std::to_string(failed) +
+                        ", hp=" + std::to_string(totalHp))));
+    }
+  };
+
 #include OATPP_CODEGEN_END(ApiController)
 };
 
@@ -151,6 +381,14 @@ void runServer() {
   // 初始化 oatpp
   oatpp::Environment::init();
   
+  // 绑定 file_identifier，使按 AnyObject 读取的 body 能分发到 Monster
+  ofb::FlatBuffersWrapper<MyGame::Example::Monster>::Class::setFileIdentifier(MyGame::Example::MonsterIdentifier());
+
+  // 可选：加载 oatpp_flatbuffers_zstd_dict_trainer 生成的字典，Accept-Encoding: zstd 时小响应也能压缩
+  if (ofb::ZstdDictionaryRegistry::instance().loadFile(MyGame::Example::MonsterIdentifier(), "res/monster.zdict")) {
+    std::cout << "Loaded zstd dictionary res/monster.zdict" << std::endl;
+  }
+
   // 创建 FlatBuffers 二进制 ObjectMapper
   auto flatbuffersMapper = std::make_shared<ofb::ObjectMapper>();
   
@@ -162,19 +400,22 @@ void runServer() {
   // 创建路由器
   auto router = oatpp::web::server::HttpRouter::createShared();
   
+  // 创建异步执行器（批量接口也在其工作线程上并行处理）
+  auto executor = std::make_shared<oatpp::async::Executor>(
+      4 /* data-processing threads */, 1 /* I/O threads */, 1 /* timer threads */);
+  
   // 创建控制器
-  auto controller = MonsterController::createShared(contentMappers);
+  auto controller = MonsterController::createShared(contentMappers, executor);
   router->addController(controller);
+  createMonsterStorage(flatbuffersMapper)->addToRouter(router);
+  // GET /metrics：ObjectMapper 指标（Prometheus 文本格式）
+  ofb::MetricsHandler::addToRouter(router);
   
   // 创建连接提供者
   auto connectionProvider = 
       oatpp::network::tcp::server::ConnectionProvider::createShared(
           {"localhost", 8000});
   
-  // 创建异步执行器
-  auto executor = std::make_shared<oatpp::async::Executor>(
-      4 /* threads */, 1 /* additional threads */, 1 /* max tasks per thread */);
-  
   // 创建连接处理器
   auto connectionHandler =
       oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
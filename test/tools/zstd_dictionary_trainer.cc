@@ -0,0 +1,133 @@
+#include "oatpp-flatbuffers/ContentEncoding.hpp"
+#include "oatpp-flatbuffers/JsonTranscodingMapper.hpp"
+#include "oatpp-flatbuffers/ZstdDictionary.hpp"
+#include "oatpp/Types.hpp"
+#include "monster_test_generated.h"
+#include "monster_test_bfbs_generated.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ofb = oatpp::flatbuffers;
+
+// 用法：oatpp_flatbuffers_zstd_dict_trainer [--json res/monsterdata_test.json] [--samples 2000]
+//                                           [--size 4096] [--seed 1] [--out monster.zdict]
+// 以 JSON 样本为模板生成字段取值不同的 Monster，训练字典并在留出的样本上对比有无字典的压缩后大小。
+// 服务端/客户端用 ZstdDictionaryRegistry::instance().loadFile("MONS", "monster.zdict") 加载同一份字典。
+
+static std::string readFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static const char* argValue(int argc, char* argv[], const char* name, const char* defaultValue) {
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::strcmp(argv[i], name) == 0) return argv[i + 1];
+  }
+  return defaultValue;
+}
+
+// 在模板上随机改动标量、字符串与向量，得到「同一类型、不同内容」的样本
+static std::vector<uint8_t> mutate(const MyGame::Example::Monster* source, std::mt19937& rng) {
+  static const char* NAMES[] = {"MyMonster", "Orc", "Goblin", "Troll", "Dragon", "Slime", "Skeleton", "Wolf"};
+  std::unique_ptr<MyGame::Example::MonsterT> monster(source->UnPack());
+  monster->hp = static_cast<int16_t>(rng() % 1000);
+  monster->mana = static_cast<int16_t>(rng() % 500);
+  monster->name = std::string(NAMES[rng() % 8]) + "-" + std::to_string(rng() % 100);
+  monster->inventory.resize(rng() % 16);
+  for (auto& item : monster->inventory) item = static_cast<uint8_t>(rng() % 32);
+  monster->testarrayofstring.resize(rng() % 6);
+  for (auto& text : monster->testarrayofstring) text = NAMES[rng() % 8];
+  monster->vector_of_doubles.resize(rng() % 8);
+  for (auto& value : monster->vector_of_doubles) value = static_cast<double>(rng() % 1000) / 8.0;
+  flatbuffers::FlatBufferBuilder builder(512);
+  MyGame::Example::FinishMonsterBuffer(builder, MyGame::Example::CreateMonster(builder, monster.get()));
+  return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+int main(int argc, char* argv[]) {
+  std::string jsonPath = argValue(argc, argv, "--json", "res/monsterdata_test.json");
+  int sampleCount = std::atoi(argValue(argc, argv, "--samples", "2000"));
+  v_buff_size dictSize = std::atoll(argValue(argc, argv, "--size", "4096"));
+  unsigned seed = static_cast<unsigned>(std::atoi(argValue(argc, argv, "--seed", "1")));
+  std::string outPath = argValue(argc, argv, "--out", "monster.zdict");
+
+  if (!ofb::ContentEncoding::isAvailable(ofb::ContentEncoding::Codec::ZSTD)) {
+    std::cerr << "zstd is not available in this build" << std::endl;
+    return 1;
+  }
+
+  auto transcoder = ofb::JsonTranscodingMapper::createShared(
+      MyGame::Example::MonsterBinarySchema::data(),
+      static_cast<v_buff_size>(MyGame::Example::MonsterBinarySchema::size()));
+  transcoder->bindRootType<MyGame::Example::Monster>("MyGame.Example.Monster");
+  oatpp::String json(readFile(jsonPath));
+  auto templateMonster = transcoder->readFromString<ofb::Object<MyGame::Example::Monster>>(json);
+  if (!templateMonster) {
+    std::cerr << "failed to parse " << jsonPath << std::endl;
+    return 1;
+  }
+
+  // 90% 训练，10% 留出评估
+  std::mt19937 rng(seed);
+  std::vector<std::vector<uint8_t>> training;
+  std::vector<std::vector<uint8_t>> holdout;
+  v_int64 rawBytes = 0;
+  for (int i = 0; i < sampleCount; ++i) {
+    auto sample = mutate(templateMonster.get()->getTable(), rng);
+    rawBytes += static_cast<v_int64>(sample.size());
+    (i % 10 == 9 ? holdout : training).push_back(std::move(sample));
+  }
+
+  std::string error;
+  auto content = ofb::ZstdDictionary::train(training, dictSize, &error);
+  if (!content) {
+    std::cerr << "training failed: " << error << std::endl;
+    return 1;
+  }
+  std::ofstream out(outPath, std::ios::binary);
+  out.write(reinterpret_cast<const char*>(content->data()), static_cast<std::streamsize>(content->size()));
+  out.close();
+
+  auto dictionary = ofb::ZstdDictionary::create(MyGame::Example::MonsterIdentifier(),
+                                                content->data(), static_cast<v_buff_size>(content->size()));
+  if (!dictionary || !ofb::ZstdDictionaryRegistry::instance().add(dictionary)) {
+    std::cerr << "trained dictionary could not be loaded" << std::endl;
+    return 1;
+  }
+
+  v_int64 holdoutRaw = 0;
+  v_int64 plainBytes = 0;
+  v_int64 dictBytes = 0;
+  for (const auto& sample : holdout) {
+    auto size = static_cast<v_buff_size>(sample.size());
+    auto plain = ofb::ContentEncoding::encode(ofb::ContentEncoding::Codec::ZSTD, sample.data(), size);
+    auto packed = dictionary->compress(sample.data(), size);
+    auto restored = packed ? ofb::ContentEncoding::decode(ofb::ContentEncoding::Codec::ZSTD,
+                                                          packed->data(), static_cast<v_buff_size>(packed->size()), size)
+                           : nullptr;
+    if (!plain || !restored || *restored != sample) {
+      std::cerr << "round trip failed" << std::endl;
+      return 1;
+    }
+    holdoutRaw += size;
+    plainBytes += static_cast<v_int64>(plain->size());
+    dictBytes += static_cast<v_int64>(packed->size());
+  }
+
+  double count = static_cast<double>(holdout.size());
+  std::cout << "samples=" << sampleCount << ", avg raw bytes=" << static_cast<double>(rawBytes) / sampleCount << std::endl;
+  std::cout << "dictionary: " << outPath << ", " << content->size() << " bytes, id=" << dictionary->getId()
+            << ", file_identifier=" << dictionary->getFileIdentifier() << std::endl;
+  std::cout << "holdout avg bytes: raw=" << holdoutRaw / count
+            << ", zstd=" << plainBytes / count
+            << ", zstd+dict=" << dictBytes / count << std::endl;
+  return 0;
+}